@@ -7,6 +7,17 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 #include "AdventOfCode.hpp"
 #include "Lanternfish.hpp"
 #include "CrabSorter.hpp"
+#include "NumberParsing.hpp"
+#include "InputBuffer.hpp"
+#include "Line2dScanner.hpp"
+#include "BitLineDecoder.hpp"
+#include "PositionalPopcount.hpp"
+#include "BitPlaneLog.hpp"
+#include "Parallel.hpp"
+#include "OverlapGrid.hpp"
+#include "OverlapSweep.hpp"
+#include "StreamingInput.hpp"
+#include "ParsedCache.hpp"
 
 #include <vector>
 #include <cstdint>
@@ -17,6 +28,7 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 #include <filesystem>
 #include <algorithm>
 #include <chrono>
+#include <atomic>
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -36,6 +48,22 @@ std::wstring Microsoft::VisualStudio::CppUnitTestFramework::ToString<aoc::bingo:
 
 const auto DATA_DIR = std::filesystem::path(R"(..\..\AdventOfCode\Data)"s);
 
+// Repeatable pseudo-random test data: a 32-bit linear congruential generator.
+class TestRandom
+{
+public:
+	explicit TestRandom(uint32_t seed) : _state{ seed } {}
+
+	uint32_t next()
+	{
+		_state = _state * 1664525 + 1013904223;
+		return _state;
+	}
+
+private:
+	uint32_t _state;
+};
+
 namespace program
 {
 TEST_CLASS(Story)
@@ -436,6 +464,13 @@ public:
 		Assert::IsFalse(aoc::is_diagonal(aoc::Line2d<uint32_t>{ {1, 1}, { 3, 5 }}));
 	}
 
+	TEST_METHOD(IsDiagonalHoldsForEndsFarApart)
+	{
+		// The distances differ by exactly 2^32.
+		Assert::IsFalse(aoc::is_diagonal(aoc::Line2d<uint32_t>{ {0, 0}, { 3'000'000'000, 1'294'967'296 }}));
+		Assert::IsTrue(aoc::is_diagonal(aoc::Line2d<uint32_t>{ {4'000'000'000, 0}, { 0, 4'000'000'000 }}));
+	}
+
 	TEST_METHOD(RasterizeVerticalLinesWorks)
 	{
 		using Line_t = aoc::Line2d<uint32_t>;
@@ -482,6 +517,175 @@ public:
 
 		Assert::IsTrue(std::equal(expected_points.begin(), expected_points.end(), points.begin()));
 	}
+
+	TEST_METHOD(RasterizeVisitsPointsInOrder)
+	{
+		using Line_t = aoc::Line2d<uint32_t>;
+		using Points_t = std::vector<aoc::Vec2d<uint32_t>>;
+		constexpr auto all = Line_t::horizontal | Line_t::vertical | Line_t::diagonal;
+
+		const auto lines_and_points = std::vector<std::pair<Line_t, Points_t>>{
+			{ { {1, 5}, { 1, 1 } }, { {1,1}, {1,2}, {1,3}, {1,4}, {1,5} } },
+			{ { {5, 1}, { 1, 1 } }, { {1,1}, {2,1}, {3,1}, {4,1}, {5,1} } },
+			{ { {4, 4}, { 1, 1 } }, { {1,1}, {2,2}, {3,3}, {4,4} } },
+			{ { {5, 1}, { 1, 5 } }, { {1,5}, {2,4}, {3,3}, {4,2}, {5,1} } },
+			{ { {2, 7}, { 4, 5 } }, { {2,7}, {3,6}, {4,5} } },
+		};
+
+		for (const auto& [line, expected_points] : lines_and_points) {
+			auto visited = Points_t{};
+			aoc::rasterize<all>(line, [&visited](const aoc::Vec2d<uint32_t>& point) { visited.push_back(point); });
+
+			Assert::IsTrue(expected_points == visited);
+			Assert::IsTrue(expected_points == aoc::rasterize<all>(line));
+		}
+	}
+
+	TEST_METHOD(RasterizeGivesHorizontalRunsToVisitorsThatTakeThem)
+	{
+		using Line_t = aoc::Line2d<uint32_t>;
+		using Point_t = aoc::Vec2d<uint32_t>;
+
+		auto runs = std::vector<std::pair<Point_t, Point_t>>{};
+		auto points = size_t{ 0 };
+		auto visit = [&](const auto&... run) {
+			if constexpr (sizeof...(run) == 2)
+				runs.emplace_back(run...);
+			else
+				++points;
+		};
+
+		aoc::rasterize<Line_t::horizontal | Line_t::vertical>(Line_t{ {5, 1}, { 1, 1 } }, visit);
+		aoc::rasterize<Line_t::horizontal | Line_t::vertical>(Line_t{ {1, 5}, { 1, 1 } }, visit);
+
+		Assert::AreEqual(size_t{ 1 }, runs.size());
+		Assert::IsTrue(Point_t{ 1, 1 } == runs[0].first);
+		Assert::IsTrue(Point_t{ 5, 1 } == runs[0].second);
+		Assert::AreEqual(size_t{ 5 }, points);
+	}
+};
+
+TEST_CLASS(Line2dScanner)
+{
+public:
+	TEST_METHOD(ScansAllRecords)
+	{
+		const auto lines = aoc::scan_line2ds<uint32_t>("0,9 -> 5,9\r\n8,0 -> 0,8\n\n9,4 -> 3,4\n");
+
+		Assert::IsTrue(lines.has_value());
+		Assert::AreEqual(size_t{ 3 }, lines->size());
+		Assert::IsTrue(aoc::Vec2d<uint32_t>{ 0, 9 } == (*lines)[0].start);
+		Assert::IsTrue(aoc::Vec2d<uint32_t>{ 0, 8 } == (*lines)[1].finish);
+		Assert::IsTrue(aoc::Vec2d<uint32_t>{ 9, 4 } == (*lines)[2].start);
+	}
+
+	TEST_METHOD(ReportsOffsetOfMalformedArrow)
+	{
+		const auto lines = aoc::scan_line2ds<uint32_t>("0,9 -> 5,9\n8,0 => 0,8\n");
+
+		Assert::IsFalse(lines.has_value());
+		Assert::AreEqual(size_t{ 15 }, lines.error().offset);
+		Assert::IsTrue(std::errc::invalid_argument == lines.error().error);
+	}
+
+	TEST_METHOD(ReportsOffsetOfOutOfRangeValue)
+	{
+		const auto lines = aoc::scan_line2ds<uint8_t>("0,9 -> 5,256");
+
+		Assert::IsFalse(lines.has_value());
+		Assert::AreEqual(size_t{ 9 }, lines.error().offset);
+		Assert::IsTrue(std::errc::result_out_of_range == lines.error().error);
+	}
+
+	TEST_METHOD(RejectsTrailingCharacters)
+	{
+		const auto lines = aoc::scan_line2ds<uint32_t>("0,9 -> 5,9 x\n");
+
+		Assert::IsFalse(lines.has_value());
+		Assert::AreEqual(size_t{ 11 }, lines.error().offset);
+	}
+
+	TEST_METHOD(ScansSignedValues)
+	{
+		const auto lines = aoc::scan_line2ds<int>("-3,4 -> 5,-2147483648");
+
+		Assert::IsTrue(lines.has_value());
+		Assert::AreEqual(-3, lines->front().start.x);
+		Assert::AreEqual(std::numeric_limits<int>::min(), lines->front().finish.y);
+	}
+};
+
+TEST_CLASS(FormatScanner)
+{
+public:
+	TEST_METHOD(ScansTypedFields)
+	{
+		const auto values = aoc::FormatScanner<"{u8}:{i64}/{u16}">::scan("255:-9223372036854775808/7");
+
+		Assert::IsTrue(values.has_value());
+		Assert::AreEqual(uint8_t{ 255 }, std::get<0>(*values));
+		Assert::AreEqual(std::numeric_limits<int64_t>::min(), std::get<1>(*values));
+		Assert::AreEqual(uint16_t{ 7 }, std::get<2>(*values));
+	}
+
+	TEST_METHOD(ScansWordsAndBits)
+	{
+		using Scanner_t = aoc::FormatScanner<"{word:forward|up|down} {bits:4}">;
+
+		const auto values = Scanner_t::scan("down 1011");
+
+		Assert::IsTrue(values.has_value());
+		Assert::AreEqual(uint8_t{ 2 }, std::get<0>(*values));
+		Assert::AreEqual(uint64_t{ 0b1011 }, std::get<1>(*values));
+
+		Assert::IsFalse(Scanner_t::scan("sideways 1011").has_value());
+		Assert::IsFalse(Scanner_t::scan("up 102").has_value());
+		Assert::IsFalse(Scanner_t::scan("up 10110").has_value());
+	}
+
+	TEST_METHOD(BlanksMatchRuns)
+	{
+		const auto values = aoc::FormatScanner<"{u8} {u8} {u8}">::scan(" 8  2\t23");
+
+		Assert::IsTrue(values.has_value());
+		Assert::IsTrue(std::tuple<uint8_t, uint8_t, uint8_t>{ 8, 2, 23 } == *values);
+	}
+
+	TEST_METHOD(TrailingBlanksAreIgnored)
+	{
+		Assert::IsTrue(std::tuple<uint8_t, uint8_t>{ 1, 2 } == *aoc::FormatScanner<"{u8},{u8}">::scan("1,2 \t"));
+		Assert::IsFalse(aoc::FormatScanner<"{u8},{u8}">::scan("1,2 x").has_value());
+
+		Assert::IsTrue(aoc::Direction{ 5, 0 } == *aoc::parse_direction("forward 5 "));
+		Assert::IsTrue(aoc::Vec2d<uint32_t>{ 1, 2 } == *aoc::parse_vec2d<uint32_t>("1,2 "));
+		Assert::IsTrue(aoc::parse_line2d<uint32_t>("0,9 -> 5,9 ").has_value());
+	}
+
+	TEST_METHOD(ReportsOffsetsWithinRecord)
+	{
+		using Scanner_t = aoc::FormatScanner<"{u8},{u8}">;
+
+		Assert::AreEqual(size_t{ 2 }, Scanner_t::scan("12;3").error().offset);
+		Assert::AreEqual(size_t{ 3 }, Scanner_t::scan("12,300").error().offset);
+		Assert::IsTrue(std::errc::result_out_of_range == Scanner_t::scan("12,300").error().error);
+		Assert::AreEqual(size_t{ 4 }, Scanner_t::scan("12,3x").error().offset);
+	}
+
+	TEST_METHOD(ForEachVisitsEveryRecord)
+	{
+		auto sum = 0;
+		const auto result = aoc::FormatScanner<"{}:{}", int>::for_each("1:2\r\n\n-3:4\n", [&sum](int a, int b) {
+			sum += a * b;
+			});
+
+		Assert::IsTrue(result.has_value());
+		Assert::AreEqual(-10, sum);
+
+		const auto error = aoc::FormatScanner<"{}:{}", int>::for_each("1:2\n3;4\n", [](int, int) {});
+
+		Assert::IsFalse(error.has_value());
+		Assert::AreEqual(size_t{ 5 }, error.error().offset);
+	}
 };
 }
 
@@ -547,6 +751,406 @@ public:
 		Assert::AreEqual(size_t{ 4 }, split_str.size());
 	}
 };
+
+TEST_CLASS(SplitView)
+{
+public:
+
+	TEST_METHOD(SplitViewTokensReferToTheSourceString)
+	{
+		const auto str = "12,345,6"s;
+		const auto tokens = split_view(str, ',');
+
+		const auto expected = { "12"s, "345"s, "6"s };
+		Assert::IsTrue(std::equal(expected.begin(), expected.end(), tokens.begin(), tokens.end()));
+
+		Assert::IsTrue(str.data() == tokens.begin()->data());
+	}
+
+	TEST_METHOD(SplitViewDropsConsecutiveDelimitersWhenOptionIsSet)
+	{
+		const auto str = "  1  2      3   "s;
+		const auto tokens = split_view(str, ' ', SplitBehaviour::drop_empty);
+
+		const auto expected = { "1"s, "2"s, "3"s };
+		Assert::IsTrue(std::equal(expected.begin(), expected.end(), tokens.begin(), tokens.end()));
+	}
+
+	TEST_METHOD(SplitViewKeepsEmptyTokensWhenOptionIsNotSet)
+	{
+		const auto str = "1,,2,"s;
+		const auto tokens = split_view(str, ',');
+
+		const auto expected = { "1"s, ""s, "2"s };
+		Assert::IsTrue(std::equal(expected.begin(), expected.end(), tokens.begin(), tokens.end()));
+	}
+
+	TEST_METHOD(SplitViewOfEmptyStringHasNoTokens)
+	{
+		const auto tokens = split_view(std::string_view{}, ',');
+
+		Assert::IsTrue(tokens.begin() == tokens.end());
+	}
+};
+
+TEST_CLASS(TryStringTo)
+{
+public:
+
+	TEST_METHOD(TryStringToConvertsValidNumbers)
+	{
+		Assert::AreEqual(-42, *try_string_to<int>("-42"));
+		Assert::AreEqual(uint8_t{ 255 }, *try_string_to<uint8_t>("255"));
+		Assert::AreEqual(18446744073709551615ull, *try_string_to<unsigned long long>("18446744073709551615"));
+	}
+
+	TEST_METHOD(TryStringToIgnoresSurroundingBlanks)
+	{
+		Assert::AreEqual(4u, *try_string_to<unsigned int>(" 4\r\n"));
+	}
+
+	TEST_METHOD(TryStringToReportsNonNumericInput)
+	{
+		Assert::IsTrue(std::errc::invalid_argument == try_string_to<int>("X").error());
+		Assert::IsTrue(std::errc::invalid_argument == try_string_to<int>("12X").error());
+		Assert::IsTrue(std::errc::invalid_argument == try_string_to<int>("").error());
+		Assert::IsTrue(std::errc::invalid_argument == try_string_to<unsigned long>("-3").error());
+	}
+
+	TEST_METHOD(TryStringToReportsOutOfRangeInput)
+	{
+		Assert::IsTrue(std::errc::result_out_of_range == try_string_to<uint8_t>("256").error());
+		Assert::IsTrue(std::errc::result_out_of_range == try_string_to<long long>("9223372036854775808").error());
+	}
+};
+}
+
+namespace number_parsing
+{
+TEST_CLASS(CsvParsing)
+{
+public:
+
+	TEST_METHOD(ParseCsvParsesLongLines)
+	{
+		auto expected = std::vector<uint32_t>{};
+		auto line = std::string{};
+		for (uint32_t i = 0; i < 1000; ++i) {
+			expected.push_back((i * 7919) % 100000);
+			line += std::to_string(expected.back()) + ",";
+		}
+		line += "4294967295\n";
+		expected.push_back(4294967295);
+
+		Assert::IsTrue(expected == *aoc::parse_csv_uint32s(line));
+	}
+
+	TEST_METHOD(ParseCsvReportsOutOfRangeValues)
+	{
+		Assert::IsTrue(std::errc::result_out_of_range == aoc::parse_csv_uint32s("1,2,4294967296").error());
+	}
+
+	TEST_METHOD(ParseCsvAcceptsBlanksAroundValues)
+	{
+		const auto values = aoc::parse_csv_uint32s("7, 4, 9, 5\r\n");
+
+		Assert::IsTrue(std::vector<uint32_t>{ 7, 4, 9, 5 } == *values);
+	}
+
+	TEST_METHOD(ParseCsvReportsMalformedValues)
+	{
+		Assert::IsTrue(std::errc::invalid_argument == aoc::parse_csv_uint32s("1,2,3,4,5,6,7,8,9,10,11,12,13,14,1X,16,17").error());
+		Assert::IsTrue(std::errc::invalid_argument == aoc::parse_csv_uint32s("1,,2").error());
+		Assert::IsTrue(std::errc::invalid_argument == aoc::parse_csv_uint32s("1,-2").error());
+	}
+
+	TEST_METHOD(ParseCsvOfEmptyLineHasNoValues)
+	{
+		Assert::IsTrue(aoc::parse_csv_uint32s("\n")->empty());
+	}
+
+	TEST_METHOD(ParseCsvHistogramCountsValues)
+	{
+		const auto histogram = aoc::parse_csv_histogram<4>("3,1,3,0,3,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2");
+
+		Assert::IsTrue(std::array<size_t, 4>{ 27, 2, 1, 3 } == *histogram);
+		Assert::IsTrue(std::errc::result_out_of_range == aoc::parse_csv_histogram<4>("3,1,4").error());
+	}
+};
+}
+
+namespace input_buffer
+{
+TEST_CLASS(InputBuffer)
+{
+public:
+
+	TEST_METHOD(MapsTheWholeFile)
+	{
+		const auto buffer = aoc::InputBuffer{ DATA_DIR / "Day1_input.txt" };
+
+		Assert::AreEqual(static_cast<size_t>(std::filesystem::file_size(DATA_DIR / "Day1_input.txt")), buffer.size());
+		Assert::IsTrue(buffer.view().starts_with("1"));
+	}
+
+	TEST_METHOD(MissingFileRaisesAocException)
+	{
+		Assert::ExpectException<aoc::Exception>([]() { aoc::InputBuffer{ DATA_DIR / "no_such_file.txt" }; });
+	}
+
+	TEST_METHOD(LineReaderStripsLineTerminators)
+	{
+		auto reader = aoc::LineReader{ "first\r\nsecond\n\nlast" };
+
+		Assert::IsTrue("first" == reader.next());
+		Assert::AreEqual(size_t{ 7 }, reader.offset());
+		Assert::IsTrue("second" == reader.next());
+		Assert::IsTrue("" == reader.next());
+		Assert::IsTrue("last" == reader.next());
+		Assert::IsTrue(reader.at_end());
+		Assert::IsFalse(reader.next().has_value());
+	}
+};
+}
+
+namespace streaming_input
+{
+TEST_CLASS(StreamingInput)
+{
+public:
+
+	TEST_METHOD(BlocksEndOnRecordBoundaries)
+	{
+		auto text = std::string{};
+		for (auto i = 0; i < 500; ++i) {
+			text += std::format("record {}\n", i * i);
+		}
+
+		std::stringstream ss(text + "last");
+		auto input = aoc::StreamingInput{ ss, 7, 3 };
+
+		auto reassembled = std::string{};
+		input.for_each_block('\n', [&](std::string_view block, size_t offset) {
+			Assert::AreEqual(reassembled.size(), offset);
+			Assert::IsTrue(block.ends_with('\n') || block == "last");
+
+			reassembled += block;
+			});
+
+		Assert::IsTrue(text + "last" == reassembled);
+	}
+
+	TEST_METHOD(OnlyTheCutRecordIsCarriedOver)
+	{
+		std::stringstream ss("ab\ncdef\ngh\nij\n");
+		auto input = aoc::StreamingInput{ ss, 6, 2 };
+
+		auto blocks = std::vector<std::pair<std::string, size_t>>{};
+		input.for_each_block('\n', [&](std::string_view block, size_t offset) { blocks.emplace_back(block, offset); });
+
+		// The chunks are "ab\ncde", "f\ngh\ni" and "j\n".
+		const auto expected = std::vector<std::pair<std::string, size_t>>{ { "ab\n", 0 }, { "cdef\n", 3 }, { "gh\n", 8 }, { "ij\n", 11 } };
+		Assert::IsTrue(expected == blocks);
+	}
+
+	TEST_METHOD(MissingFileRaisesAocException)
+	{
+		Assert::ExpectException<aoc::Exception>([]() { aoc::StreamingInput{ DATA_DIR / "no_such_file.txt" }; });
+	}
+
+	TEST_METHOD(AbandoningTheInputStopsTheReader)
+	{
+		std::stringstream ss(std::string(1 << 16, 'x') + "\n");
+		auto input = aoc::StreamingInput{ ss, 16, 2 };
+
+		Assert::ExpectException<aoc::Exception>([&]() {
+			input.for_each_block('x', [](std::string_view, size_t) { throw aoc::Exception("Stop"); });
+			});
+	}
+
+	TEST_METHOD(StreamedReductionsMatchLoadedOnes)
+	{
+		auto depths = aoc::StreamingInput{ DATA_DIR / "Day1_input.txt", 64, 2 };
+		Assert::AreEqual(uint32_t{ 1538 }, aoc::Submarine().boat_systems().depth_score<3>(depths));
+
+		std::ifstream data_file(DATA_DIR / "Day2_input.txt");
+		Assert::IsTrue(data_file.is_open());
+
+		using StreamIter_t = std::istream_iterator<aoc::Direction>;
+		const auto expected_aiming = aoc::Submarine().boat_systems().net_aiming(StreamIter_t(data_file), StreamIter_t());
+
+		auto course = aoc::StreamingInput{ DATA_DIR / "Day2_input.txt", 100, 3 };
+		Assert::IsTrue(expected_aiming == aoc::Submarine().boat_systems().net_aiming(course));
+
+		auto log = aoc::StreamingInput{ DATA_DIR / "Day3_input.txt", 50, 4 };
+		Assert::AreEqual(uint32_t{ 693486 }, aoc::Submarine().boat_systems().power_consumption(log));
+
+		auto shoal = aoc::StreamingInput{ DATA_DIR / "Day6_input.txt", 16, 2 };
+		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 360268 }, aoc::LanternfishShoalModel{ shoal }.run_for(std::chrono::days(80)).shoal_size());
+	}
+};
+}
+
+namespace parsed_cache
+{
+TEST_CLASS(ParsedCache)
+{
+public:
+
+	static std::filesystem::path scratch_dir()
+	{
+		const auto out = std::filesystem::temp_directory_path() / "aoc_parsed_cache_tests";
+		std::filesystem::create_directories(out);
+
+		return out;
+	}
+
+	static void write_file(const std::filesystem::path& path, std::string_view text)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << text;
+	}
+
+	TEST_METHOD(ContentHashDependsOnEveryByte)
+	{
+		const auto text = std::string{ "0,9 -> 5,9\n8,0 -> 0,8\n" };
+		const auto hash = aoc::content_hash(text);
+
+		// Even the low bits of the hash change, wherever in a word the changed byte is.
+		for (size_t i = 0; i < text.size(); ++i) {
+			auto changed = text;
+			changed[i] ^= 0x40;
+			Assert::IsTrue((hash & 0xFFFF) != (aoc::content_hash(changed) & 0xFFFF));
+		}
+	}
+
+	TEST_METHOD(CacheIsOnlyRebuiltWhenTheSourceChanges)
+	{
+		const auto source_path = scratch_dir() / "vents.txt";
+		const auto cache_path = aoc::ParsedCache::default_path(source_path);
+		std::filesystem::remove(cache_path);
+
+		write_file(source_path, "0,9 -> 5,9\n8,0 -> 0,8\n");
+		Assert::IsTrue(aoc::cache_vent_lines(source_path, cache_path).rebuilt());
+
+		const auto cache = aoc::cache_vent_lines(source_path, cache_path);
+		Assert::IsFalse(cache.rebuilt());
+
+		const auto lines = cache.section<aoc::Line2d<uint32_t>>(0);
+		Assert::AreEqual(size_t{ 2 }, lines.size());
+		Assert::IsTrue(aoc::Vec2d<uint32_t>{ 8, 0 } == lines[1].start);
+
+		write_file(source_path, "0,9 -> 5,9\n8,0 -> 0,9\n");
+		const auto rebuilt = aoc::cache_vent_lines(source_path, cache_path);
+		Assert::IsTrue(rebuilt.rebuilt());
+		Assert::IsTrue(aoc::Vec2d<uint32_t>{ 0, 9 } == rebuilt.section<aoc::Line2d<uint32_t>>(0)[1].finish);
+	}
+
+	TEST_METHOD(CorruptCacheIsRebuilt)
+	{
+		const auto source_path = scratch_dir() / "positions.txt";
+		const auto cache_path = aoc::ParsedCache::default_path(source_path);
+
+		write_file(source_path, "16,1,2,0,4,2,7,1,2,14");
+		write_file(cache_path, "not a cache");
+
+		const auto cache = aoc::cache_positions(source_path, cache_path);
+		Assert::IsTrue(cache.rebuilt());
+		Assert::AreEqual(size_t{ 10 }, cache.section<uint32_t>(0).size());
+		Assert::ExpectException<aoc::Exception>([&]() { cache.section<uint64_t>(0); });
+	}
+
+	TEST_METHOD(CachedInputsGiveTheSameAnswers)
+	{
+		const auto cache_dir = scratch_dir();
+
+		for (auto pass = 0; pass < 2; ++pass) {
+			const auto vents = aoc::cache_vent_lines(DATA_DIR / "Day5_input.txt", cache_dir / "Day5.aoccache");
+			Assert::AreEqual(uint32_t{ 20196 }, aoc::Submarine().boat_systems()
+				.detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>(vents.section<aoc::Line2d<uint32_t>>(0)));
+
+			const auto entries = aoc::cache_diagnostic_log(DATA_DIR / "Day3_input.txt", cache_dir / "Day3.aoccache", aoc::DiagnosticLog::entry_size);
+			auto log = aoc::DiagnosticLog{};
+			log.load(entries.section<uint64_t>(0));
+			Assert::AreEqual(uint32_t{ 693486 }, aoc::Submarine().boat_systems().power_consumption(log));
+
+			const auto bingo = aoc::cache_bingo_game(DATA_DIR / "Day4_input.txt", cache_dir / "Day4.aoccache");
+			Assert::AreEqual(uint32_t{ 2745 }, *aoc::Submarine().entertainment().bingo_game()
+				.load(bingo.section<uint8_t>(0), bingo.section<uint8_t>(1))
+				.play_to_win()
+				.score());
+
+			const auto positions = aoc::cache_positions(DATA_DIR / "Day7_input.txt", cache_dir / "Day7.aoccache");
+			const auto [best_position, cost] = aoc::CrabSorter{}
+				.load(positions.section<uint32_t>(0))
+				.best_position_and_cost([](uint32_t distance) { return distance; });
+			Assert::AreEqual(size_t{ 330 }, best_position);
+			Assert::AreEqual(uint32_t{ 329389 }, cost);
+		}
+	}
+};
+}
+
+namespace parallel
+{
+TEST_CLASS(ThreadPool)
+{
+public:
+	TEST_METHOD(RunsEveryTaskOnce)
+	{
+		auto pool = aoc::ThreadPool{ 4 };
+		auto runs = std::vector<std::atomic<int>>(1000);
+
+		pool.run(runs.size(), [&runs](size_t i) { ++runs[i]; });
+
+		Assert::IsTrue(std::all_of(runs.begin(), runs.end(), [](const auto& count) { return 1 == count; }));
+	}
+
+	TEST_METHOD(RethrowsTaskExceptions)
+	{
+		auto pool = aoc::ThreadPool{ 4 };
+
+		Assert::ExpectException<aoc::Exception>([&pool]() {
+			pool.run(100, [](size_t i) {
+				if (57 == i)
+					throw aoc::Exception("Task failed");
+				});
+			});
+
+		// Still usable afterwards
+		auto total = std::atomic<size_t>{ 0 };
+		pool.run(100, [&total](size_t i) { total += i; });
+		Assert::AreEqual(size_t{ 4950 }, total.load());
+	}
+
+	TEST_METHOD(NestedRunsExecuteInline)
+	{
+		auto pool = aoc::ThreadPool{ 3 };
+		auto total = std::atomic<size_t>{ 0 };
+
+		pool.run(10, [&](size_t) {
+			pool.run(10, [&total](size_t j) { total += j; });
+			});
+
+		Assert::AreEqual(size_t{ 450 }, total.load());
+	}
+
+	TEST_METHOD(ChunksCoverTheRange)
+	{
+		auto pool = aoc::ThreadPool{ 4 };
+		auto covered = std::vector<std::atomic<int>>(1003);
+
+		const auto chunk_count = aoc::parallel_chunks(pool, covered.size(), 100, [&covered](size_t, size_t first, size_t last) {
+			for (auto i = first; i < last; ++i) {
+				++covered[i];
+			}
+			});
+
+		Assert::AreEqual(size_t{ 4 }, chunk_count);
+		Assert::IsTrue(std::all_of(covered.begin(), covered.end(), [](const auto& count) { return 1 == count; }));
+		Assert::AreEqual(size_t{ 1 }, aoc::parallel_chunks(pool, 50, 100, [](size_t, size_t, size_t) {}));
+	}
+};
 }
 
 namespace boat_systems
@@ -604,6 +1208,52 @@ public:
 		Assert::AreEqual(30, direction.y);
 	}
 
+	TEST_METHOD(ParseDirectionColumns)
+	{
+		const auto columns = aoc::parse_direction_columns("forward 5\ndown 5\r\nforward 8\nup 3\n\ndown 8\nforward 2\n");
+
+		Assert::IsTrue(columns.has_value());
+		Assert::IsTrue(std::vector<int>{ 5, 0, 8, 0, 0, 2 } == columns->x);
+		Assert::IsTrue(std::vector<int>{ 0, 5, 0, -3, 8, 0 } == columns->y);
+
+		Assert::IsTrue(aoc::Direction{ 15, 10 } == aoc::Submarine().boat_systems().net_direction(*columns));
+		Assert::IsTrue(aoc::Direction{ 15, 60 } == aoc::Submarine().boat_systems().net_aiming(*columns));
+	}
+
+	TEST_METHOD(DirectionColumnsMatchPerTokenParsing)
+	{
+		auto text = std::string{};
+		for (auto i = 0; i < 101; ++i) {
+			text += std::format("{} {}\n", (i % 3 == 0 ? "forward" : i % 3 == 1 ? "down" : "up"), (i * 7) % 10);
+		}
+
+		std::stringstream ss(text);
+		const auto directions = std::vector<aoc::Direction>(std::istream_iterator<aoc::Direction>(ss), std::istream_iterator<aoc::Direction>());
+		const auto columns = aoc::parse_direction_columns(text);
+
+		Assert::IsTrue(columns.has_value());
+		Assert::IsTrue(aoc::Submarine().boat_systems().net_direction(directions.begin(), directions.end())
+			== aoc::Submarine().boat_systems().net_direction(*columns));
+		Assert::IsTrue(aoc::Submarine().boat_systems().net_aiming(directions.begin(), directions.end())
+			== aoc::Submarine().boat_systems().net_aiming(*columns));
+	}
+
+	TEST_METHOD(DirectionColumnsReportOffsetOfInvalidCommand)
+	{
+		const auto columns = aoc::parse_direction_columns("forward 5\ndowm 5\n");
+
+		Assert::IsFalse(columns.has_value());
+		Assert::AreEqual(size_t{ 10 }, columns.error().offset);
+	}
+
+	TEST_METHOD(DirectionColumnsReportOffsetOfInvalidMagnitude)
+	{
+		const auto columns = aoc::parse_direction_columns("forward 5\nup 5x\n");
+
+		Assert::IsFalse(columns.has_value());
+		Assert::AreEqual(size_t{ 14 }, columns.error().offset);
+	}
+
 	TEST_METHOD(ParseDirectionsFromStream)
 	{
 		std::stringstream ss("forward 3\ndown 3\nforward 12\ndown 5\nup 2");
@@ -674,6 +1324,185 @@ public:
 		Assert::AreEqual(15, net_aim.x);
 		Assert::AreEqual(60, net_aim.y);
 	}
+
+	TEST_METHOD(ComposedAimingsMatchFoldingAllTheCommands)
+	{
+		const auto commands = std::vector<aoc::Direction>{ { 5, 0 }, { 0, 5 }, { 8, 0 }, { 0, -3 }, { 0, 8 }, { 2, 0 } };
+
+		for (size_t split = 0; split <= commands.size(); ++split) {
+			const auto first = std::accumulate(commands.begin(), commands.begin() + split, aoc::Aiming{});
+			const auto second = std::accumulate(commands.begin() + split, commands.end(), aoc::Aiming{});
+
+			Assert::IsTrue(aoc::Aiming{ 15, 10, 60 } == first.then(second));
+		}
+	}
+
+	TEST_METHOD(ParallelAimingMatchesSequentialAiming)
+	{
+		const auto directions = make_directions(3 * aoc::parallel_min_directions + 123);
+		const auto expected = aoc::aiming_of(directions.x, directions.y);
+
+		for (const auto thread_count : { size_t{ 1 }, size_t{ 3 }, size_t{ 8 } }) {
+			auto pool = aoc::ThreadPool{ thread_count };
+
+			Assert::IsTrue(expected == aoc::aiming_of(directions, pool));
+			Assert::IsTrue(expected.to_direction() == aoc::Submarine().boat_systems().net_aiming(directions, pool));
+		}
+	}
+
+	TEST_METHOD(ParallelTrajectoryMatchesStepByStepAiming)
+	{
+		const auto directions = make_directions(2 * aoc::parallel_min_directions + 45);
+
+		auto pool = aoc::ThreadPool{ 4 };
+		const auto trajectory = aoc::Submarine().boat_systems().aiming_trajectory(directions, pool);
+
+		Assert::AreEqual(directions.size(), trajectory.size());
+
+		auto state = aoc::Aiming{};
+		for (size_t i = 0; i < directions.size(); ++i) {
+			state = state + aoc::Direction{ directions.x[i], directions.y[i] };
+			Assert::IsTrue(state == trajectory[i]);
+		}
+	}
+
+	TEST_METHOD(WideAccumulatorsMatchAStepByStepFold)
+	{
+		auto directions = aoc::DirectionColumns{};
+		for (size_t i = 0; i < 10'000; ++i) {
+			directions.x.push_back(i % 2 ? 60'000 : 0);
+			directions.y.push_back(i % 2 ? 0 : 70'000);
+		}
+
+		auto expected = aoc::BasicAiming<int64_t>{};
+		for (size_t i = 0; i < directions.size(); ++i) {
+			expected = expected + aoc::Direction{ directions.x[i], directions.y[i] };
+		}
+
+		Assert::IsTrue(expected.depth > std::numeric_limits<int>::max());
+
+		const auto& boat_systems = aoc::Submarine().boat_systems();
+		Assert::IsTrue(expected == aoc::aiming_of<int64_t>(directions.x, directions.y));
+		Assert::IsTrue(expected == aoc::aiming_of<int64_t, aoc::Overflow::check>(directions.x, directions.y));
+		Assert::IsTrue(expected.to_direction() == boat_systems.net_aiming<int64_t>(directions));
+		Assert::IsTrue(aoc::Vec2d<int64_t>{ 300'000'000, 350'000'000 } == boat_systems.net_direction<int64_t>(directions));
+
+		auto pool = aoc::ThreadPool{ 3 };
+		Assert::IsTrue(expected.to_direction() == boat_systems.net_aiming<int64_t, aoc::Overflow::check>(directions, pool));
+
+#if defined(AOC_HAVE_INT128)
+		Assert::IsTrue(expected.as<aoc::int128_t>() == aoc::aiming_of<aoc::int128_t>(directions.x, directions.y));
+#endif
+
+		Assert::IsTrue(aoc::Direction{ 300'000'000, 350'000'000 } == boat_systems.net_direction<int, aoc::Overflow::check>(directions));
+		Assert::ExpectException<aoc::Exception>([&]() { boat_systems.net_aiming<int, aoc::Overflow::check>(directions); });
+	}
+
+	TEST_METHOD(WrappingAimingIsModular)
+	{
+		// Overflows an int many times over; the vector lanes and the scalar tail must wrap alike.
+		for (const auto count : { size_t{ 10'000 }, size_t{ 10'003 }, size_t{ 10'005 } }) {
+			auto directions = aoc::DirectionColumns{};
+			auto commands = std::vector<aoc::Direction>{};
+			for (size_t i = 0; i < count; ++i) {
+				directions.x.push_back(i % 2 ? 60'000 : 0);
+				directions.y.push_back(i % 2 ? 0 : 70'000);
+				commands.push_back({ directions.x.back(), directions.y.back() });
+			}
+
+			const auto wide = aoc::aiming_of<int64_t>(directions.x, directions.y);
+			const auto narrow = aoc::aiming_of(directions.x, directions.y);
+
+			Assert::AreEqual(static_cast<int>(wide.depth), narrow.depth);
+			Assert::IsTrue(wide.as<int>() == narrow);
+			Assert::IsTrue(narrow.to_direction() == aoc::Submarine().boat_systems().net_aiming(commands.begin(), commands.end()));
+
+			auto pool = aoc::ThreadPool{ 3 };
+			Assert::IsTrue(narrow == aoc::aiming_trajectory_of(directions, pool).back());
+			Assert::ExpectException<aoc::Exception>([&]() { aoc::aiming_trajectory_of<int, aoc::Overflow::check>(directions, pool); });
+		}
+	}
+
+	TEST_METHOD(CheckedReductionsDoNotDependOnGrouping)
+	{
+		const auto& boat_systems = aoc::Submarine().boat_systems();
+
+		// The second chunk, from zero aim, reaches a depth of 2^32, but the boat itself never leaves
+		// the surface.
+		auto directions = aoc::DirectionColumns{};
+		directions.x.resize(2 * aoc::parallel_min_directions);
+		directions.y.resize(directions.x.size());
+		directions.y.front() = -(1 << 20);
+		directions.y[aoc::parallel_min_directions] = 1 << 20;
+		std::fill_n(directions.x.begin() + aoc::parallel_min_directions + 1, 1 << 12, 1);
+
+		const auto expected = aoc::BasicAiming<int>{ 1 << 12, 0, 0 };
+		Assert::IsTrue(expected == aoc::aiming_of<int, aoc::Overflow::check>(directions.x, directions.y));
+
+		auto pool = aoc::ThreadPool{ 2 };
+		Assert::IsTrue(expected.to_direction() == boat_systems.net_aiming<int, aoc::Overflow::check>(directions, pool));
+		Assert::IsTrue(expected == aoc::aiming_trajectory_of<int, aoc::Overflow::check>(directions, pool).back());
+
+		// The same in blocks of 61 bytes, the first of which holds the first six lines.
+		auto course_text = std::string{ "up 1048576\n" };
+		for (auto i = 0; i < 5; ++i) {
+			course_text += "forward 0\n";
+		}
+
+		course_text += "down 1048576\nforward 4096\n";
+
+		std::stringstream course_stream(course_text);
+		auto course = aoc::StreamingInput{ course_stream, 61, 2 };
+		Assert::IsTrue(aoc::Direction{ 4096, 0 } == boat_systems.net_aiming<int, aoc::Overflow::check>(course));
+
+		// A block of 32 bytes that goes down 4'000'000'000, and one that comes back up.
+		std::stringstream heading_stream("down 2000000000\ndown 2000000000\nup 2000000000\nup 2000000000\n");
+		auto heading = aoc::StreamingInput{ heading_stream, 32, 2 };
+		Assert::IsTrue(aoc::Direction{ 0, 0 } == boat_systems.net_direction<int, aoc::Overflow::check>(heading));
+	}
+
+	TEST_METHOD(CheckedAimingOnlyThrowsWhenAValueDoesNotFit)
+	{
+		constexpr auto step = 1 << 30;
+
+		// Large enough that the bounds don't fit in 64 bits, although the aim comes back to zero.
+		auto directions = aoc::DirectionColumns{};
+		for (const auto& [x, y] : { std::pair{ 0, step }, std::pair{ 0, -step }, std::pair{ step, 0 } }) {
+			directions.x.insert(directions.x.end(), 8, x);
+			directions.y.insert(directions.y.end(), 8, y);
+		}
+
+		Assert::IsTrue(aoc::BasicAiming<int64_t>{ int64_t{ 8 } * step, 0, 0 } == aoc::aiming_of<int64_t, aoc::Overflow::check>(directions.x, directions.y));
+		Assert::ExpectException<aoc::Exception>([&]() { aoc::aiming_of<int, aoc::Overflow::check>(directions.x, directions.y); });
+
+		// Now the depth reaches 8 * 2^30 * 8 * 2^30 = 2^66.
+		std::fill(directions.y.begin() + 8, directions.y.begin() + 16, 0);
+		Assert::ExpectException<aoc::Exception>([&]() { aoc::aiming_of<int64_t, aoc::Overflow::check>(directions.x, directions.y); });
+
+#if defined(AOC_HAVE_INT128)
+		const auto wide = aoc::aiming_of<aoc::int128_t>(directions.x, directions.y);
+		Assert::IsTrue(aoc::int128_t{ 1 } << 66 == wide.depth);
+		Assert::IsTrue(aoc::int128_t{ 8 } * step == wide.aim);
+#endif
+	}
+
+private:
+
+	// Real commands move either forward or up/down, so the aim wanders but stays small.
+	static aoc::DirectionColumns make_directions(size_t count)
+	{
+		auto out = aoc::DirectionColumns{};
+		auto random = TestRandom{ 7 };
+		for (size_t i = 0; i < count; ++i) {
+			const auto state = random.next();
+			const auto command = (state >> 16) % 3;
+			const auto magnitude = static_cast<int>((state >> 20) % 5);
+			out.x.push_back(0 == command ? magnitude : 0);
+			out.y.push_back(0 == command ? 0 : (1 == command ? -magnitude : magnitude));
+		}
+
+		return out;
+	}
 };
 
 TEST_CLASS(DepthMeasurements)
@@ -706,6 +1535,111 @@ public:
 
 		Assert::AreEqual(uint32_t{ 7 }, depth_score);
 	}
+
+	TEST_METHOD(SpanDepthScoreMatchesIteratorVersion)
+	{
+		const auto depths = make_depths(1'037, 99, 8);
+
+		const auto boat_systems = aoc::Submarine().boat_systems();
+		const auto span = std::span<const uint32_t>{ depths };
+
+		Assert::AreEqual(boat_systems.depth_score<1>(depths.begin(), depths.end()), boat_systems.depth_score<1>(span));
+
+		// The compare is unsigned. (Wider windows would overflow the iterator version's running sum here.)
+		auto deep = depths;
+		std::transform(deep.begin(), deep.end(), deep.begin(), [](uint32_t depth) { return depth % 3 ? depth : depth | 0x80000000u; });
+		Assert::AreEqual(boat_systems.depth_score<1>(deep.begin(), deep.end()), boat_systems.depth_score<1>(std::span<const uint32_t>{ deep }));
+		Assert::AreEqual(boat_systems.depth_score<3>(depths.begin(), depths.end()), boat_systems.depth_score<3>(span));
+		Assert::AreEqual(boat_systems.depth_score<17>(depths.begin(), depths.end()), boat_systems.depth_score<17>(span));
+
+		Assert::AreEqual(uint32_t{ 5 }, boat_systems.depth_score<3>(std::span<const uint32_t>{ std::vector<uint32_t>{ 199, 200, 208, 210, 200, 207, 240, 269, 260, 263 } }));
+		Assert::AreEqual(uint32_t{ 0 }, boat_systems.depth_score<3>(span.first(3)));
+	}
+
+	TEST_METHOD(MultiWindowScoresMatchSingleWindowOnes)
+	{
+		const auto depths = make_depths(10'007, 31, 12);
+
+		const auto boat_systems = aoc::Submarine().boat_systems();
+		const auto span = std::span<const uint32_t>{ depths };
+
+		const auto window_sizes = std::vector<size_t>{ 1, 2, 3, 4, 5, 8, 4'500, 20'000 };
+		const auto scores = boat_systems.depth_scores(span, window_sizes);
+
+		Assert::AreEqual(window_sizes.size(), scores.size());
+		Assert::AreEqual(boat_systems.depth_score<1>(depths.begin(), depths.end()), scores[0]);
+		Assert::AreEqual(boat_systems.depth_score<3>(depths.begin(), depths.end()), scores[2]);
+		Assert::AreEqual(boat_systems.depth_score<5>(span), scores[4]);
+		Assert::AreEqual(uint32_t{ 0 }, scores[7]);
+
+		for (size_t w = 0; w < window_sizes.size(); ++w) {
+			Assert::AreEqual(boat_systems.depth_score(span, window_sizes[w]), scores[w]);
+			Assert::AreEqual(aoc::detail::count_window_increases<0>(span, window_sizes[w]), scores[w]);
+		}
+	}
+
+	TEST_METHOD(SonarScorerMatchesBatchScore)
+	{
+		const auto depths = make_depths(1'000, 7, 16);
+
+		const auto span = std::span<const uint32_t>{ depths };
+
+		auto one_by_one = aoc::SonarScorer<3>{};
+		auto in_batches = aoc::SonarScorer<3>{};
+		for (size_t first = 0, batch = 1; first < depths.size(); first += batch, batch = batch % 7 + 1) {
+			const auto batch_depths = span.subspan(first, std::min(batch, depths.size() - first));
+			for (const auto depth : batch_depths) {
+				one_by_one.push(depth);
+			}
+
+			in_batches.push(batch_depths);
+
+			const auto expected = aoc::count_window_increases(span.first(first + batch_depths.size()), 3);
+			Assert::AreEqual(expected, one_by_one.count());
+			Assert::AreEqual(expected, in_batches.count());
+		}
+	}
+
+	TEST_METHOD(SonarScorerScoresExampleValues)
+	{
+		auto scorer = aoc::SonarScorer<3>{};
+		for (const auto depth : { 199, 200, 208, 210, 200, 207, 240, 269, 260, 263 }) {
+			scorer.push(static_cast<uint32_t>(depth));
+		}
+
+		Assert::AreEqual(uint32_t{ 5 }, scorer.count());
+	}
+
+	TEST_METHOD(ParallelDepthScoreMatchesSequentialOne)
+	{
+		// Several chunks' worth, with chunk boundaries that don't line up with anything in particular
+		const auto depths = make_depths(3 * aoc::parallel_min_depth_compares + 12'345, 4242, 12);
+
+		const auto boat_systems = aoc::Submarine().boat_systems();
+		const auto span = std::span<const uint32_t>{ depths };
+
+		for (const auto thread_count : { size_t{ 1 }, size_t{ 3 }, size_t{ 8 } }) {
+			auto pool = aoc::ThreadPool{ thread_count };
+			Assert::AreEqual(boat_systems.depth_score<1>(span), boat_systems.depth_score<1>(span, pool));
+			Assert::AreEqual(boat_systems.depth_score<3>(span), boat_systems.depth_score<3>(span, pool));
+			Assert::AreEqual(boat_systems.depth_score<100>(span), boat_systems.depth_score<100>(span, pool));
+		}
+
+		auto pool = aoc::ThreadPool{ 4 };
+		Assert::AreEqual(uint32_t{ 0 }, boat_systems.depth_score<3>(span.first(3), pool));
+	}
+
+private:
+
+	// Depths below 2^(32 - shift).
+	static std::vector<uint32_t> make_depths(size_t count, uint32_t seed, uint32_t shift)
+	{
+		auto out = std::vector<uint32_t>(count);
+		auto random = TestRandom{ seed };
+		std::generate(out.begin(), out.end(), [&random, shift]() { return random.next() >> shift; });
+
+		return out;
+	}
 };
 
 TEST_CLASS(LifeSupportSystems)
@@ -772,6 +1706,25 @@ public:
 		const auto best_match = aoc::LifeSupport(log).filter_using_least_frequent_bits();
 		Assert::AreEqual(uint32_t{ 0b10100000000 }, best_match);
 	}
+
+	TEST_METHOD(SharedBitsAndDuplicatesKeepSurvivors)
+	{
+		constexpr auto log_lines =
+			"000000000011\n"
+			"000000000001\n"
+			"000000000101\n"
+			"000000000101";
+
+		std::stringstream ss(log_lines);
+		const auto life_support = aoc::LifeSupport(aoc::DiagnosticLog{ ss });
+
+		// Queries reuse the same index.
+		for (auto pass = 0; pass < 2; ++pass) {
+			Assert::AreEqual(uint32_t{ 0b101 }, life_support.filter_using_most_frequent_bits());
+			Assert::AreEqual(uint32_t{ 0b1 }, life_support.filter_using_least_frequent_bits());
+			Assert::AreEqual(uint32_t{ 5 }, life_support.rating());
+		}
+	}
 };
 
 TEST_CLASS(VentAnalysis)
@@ -779,40 +1732,208 @@ TEST_CLASS(VentAnalysis)
 public:
 	TEST_METHOD(VentAnalyserScoresExampleData)
 	{
-		constexpr auto data_str =
-			"0,9 -> 5,9\n"
-			"8,0 -> 0,8\n"
-			"9,4 -> 3,4\n"
-			"2,2 -> 2,1\n"
-			"7,0 -> 7,4\n"
-			"6,4 -> 2,0\n"
-			"0,9 -> 2,9\n"
-			"3,4 -> 1,4\n"
-			"0,0 -> 8,8\n"
-			"5,5 -> 8,2";
+		constexpr auto data_str =
+			"0,9 -> 5,9\n"
+			"8,0 -> 0,8\n"
+			"9,4 -> 3,4\n"
+			"2,2 -> 2,1\n"
+			"7,0 -> 7,4\n"
+			"6,4 -> 2,0\n"
+			"0,9 -> 2,9\n"
+			"3,4 -> 1,4\n"
+			"0,0 -> 8,8\n"
+			"5,5 -> 8,2";
+
+		std::stringstream data{ data_str };
+
+		Assert::AreEqual(uint32_t{ 5 }, aoc::VentAnalyzer{ data }.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>());
+	}
+	TEST_METHOD(VentAnalyserScoresExampleDataWithDiagonals)
+	{
+		constexpr auto data_str =
+			"0,9 -> 5,9\n"
+			"8,0 -> 0,8\n"
+			"9,4 -> 3,4\n"
+			"2,2 -> 2,1\n"
+			"7,0 -> 7,4\n"
+			"6,4 -> 2,0\n"
+			"0,9 -> 2,9\n"
+			"3,4 -> 1,4\n"
+			"0,0 -> 8,8\n"
+			"5,5 -> 8,2";
+
+		std::stringstream data{ data_str };
+
+		Assert::AreEqual(uint32_t{ 12 }, aoc::VentAnalyzer{ data }
+		.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>());
+	}
+
+	TEST_METHOD(OverlapGridCountsEachCellOnce)
+	{
+		auto grid = aoc::OverlapGrid{ { 10, 20 }, { 12, 21 } };
+
+		grid.add({ 10, 20 });
+		grid.add({ 12, 21 });
+		Assert::AreEqual(uint32_t{ 0 }, grid.overlaps());
+
+		grid.add({ 12, 21 });
+		grid.add({ 12, 21 });
+		grid.add({ 11, 21 });
+		Assert::AreEqual(uint32_t{ 1 }, grid.overlaps());
+
+		grid.add({ 10, 20 });
+		Assert::AreEqual(uint32_t{ 2 }, grid.overlaps());
+	}
+
+	TEST_METHOD(OverlapGridRunsMatchSinglePoints)
+	{
+		auto by_run = aoc::OverlapGrid{ { 3, 0 }, { 202, 2 } };
+		auto by_point = aoc::OverlapGrid{ { 3, 0 }, { 202, 2 } };
+
+		for (const auto& [y, first, last] : { std::tuple{ 1u, 3u, 202u }, std::tuple{ 1u, 50u, 180u }, std::tuple{ 2u, 60u, 60u }, std::tuple{ 1u, 100u, 140u } }) {
+			by_run.add({ first, y }, { last, y });
+			for (auto x = first; x <= last; ++x) {
+				by_point.add({ x, y });
+			}
+		}
+
+		Assert::AreEqual(uint32_t{ 131 }, by_point.overlaps());
+		Assert::AreEqual(by_point.overlaps(), by_run.overlaps());
+	}
+
+	TEST_METHOD(SweepEngineScoresExampleData)
+	{
+		constexpr auto data_str =
+			"0,9 -> 5,9\n"
+			"8,0 -> 0,8\n"
+			"9,4 -> 3,4\n"
+			"2,2 -> 2,1\n"
+			"7,0 -> 7,4\n"
+			"6,4 -> 2,0\n"
+			"0,9 -> 2,9\n"
+			"3,4 -> 1,4\n"
+			"0,0 -> 8,8\n"
+			"5,5 -> 8,2";
+
+		std::stringstream data{ data_str };
+		const auto analyzer = aoc::VentAnalyzer{ data };
+
+		Assert::AreEqual(uint64_t{ 5 }, analyzer.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical, aoc::VentAnalyzer::Engine::sweep>());
+		Assert::AreEqual(uint64_t{ 12 }, analyzer.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal, aoc::VentAnalyzer::Engine::sweep>());
+	}
+
+	TEST_METHOD(SweepEngineMatchesRasterEngine)
+	{
+		using Analyzer_t = aoc::VentAnalyzer;
+		using Line_t = aoc::Line2d<uint32_t>;
+
+		auto random = TestRandom{ 5 };
+		auto next = [&random](uint32_t bound) { return (random.next() >> 8) % bound; };
+
+		for (size_t round = 0; round < 20; ++round) {
+			// Small boxes, so that lines overlap, touch and cross a lot.
+			auto lines = std::vector<Line_t>{};
+			for (size_t i = 0; i < 150; ++i) {
+				const auto start = aoc::Vec2d<uint32_t>{ next(40), next(40) };
+				const auto length = next(15);
+				switch (next(4))
+				{
+				case 0: lines.push_back({ start, { start.x + length, start.y } }); break;
+				case 1: lines.push_back({ start, { start.x, start.y + length } }); break;
+				case 2: lines.push_back({ { start.x + length, start.y + length }, start }); break;
+				default: lines.push_back({ { start.x, start.y + length }, { start.x + length, start.y } }); break;
+				}
+			}
+
+			Assert::AreEqual(uint64_t{ Analyzer_t::score<Analyzer_t::horizontal | Analyzer_t::vertical>(lines) },
+				Analyzer_t::score<Analyzer_t::horizontal | Analyzer_t::vertical, Analyzer_t::Engine::sweep>(lines));
+			Assert::AreEqual(uint64_t{ Analyzer_t::score<Analyzer_t::diagonal>(lines) },
+				Analyzer_t::score<Analyzer_t::diagonal, Analyzer_t::Engine::sweep>(lines));
+			Assert::AreEqual(uint64_t{ Analyzer_t::score<Analyzer_t::horizontal | Analyzer_t::vertical | Analyzer_t::diagonal>(lines) },
+				Analyzer_t::score<Analyzer_t::horizontal | Analyzer_t::vertical | Analyzer_t::diagonal, Analyzer_t::Engine::sweep>(lines));
+		}
+	}
+
+	TEST_METHOD(SweepEngineSkipsDiagonalsThatCrossBetweenCells)
+	{
+		using Analyzer_t = aoc::VentAnalyzer;
+		using Line_t = aoc::Line2d<uint32_t>;
+
+		// Every rising line crosses every falling one, but always between cells: y - x is odd on
+		// the rising lines and x + y even on the falling ones.
+		auto lines = std::vector<Line_t>{};
+		for (uint32_t k = 0; k < 3'000; ++k) {
+			lines.push_back({ { 0, 2 * k + 1 }, { 1'000'000, 1'000'000 + 2 * k + 1 } });
+			lines.push_back({ { 0, 1'000'000 + 2 * k }, { 1'000'000 + 2 * k, 0 } });
+		}
+
+		Assert::AreEqual(uint64_t{ 0 }, Analyzer_t::score<Analyzer_t::diagonal, Analyzer_t::Engine::sweep>(lines));
+	}
+
+	TEST_METHOD(SweepEngineDoesNotDependOnLineLength)
+	{
+		using Analyzer_t = aoc::VentAnalyzer;
+		using Line_t = aoc::Line2d<uint32_t>;
+
+		// Two collinear lines sharing 3'000'000'001 cells, crossed by a vertical and two diagonals.
+		const auto lines = std::vector<Line_t>{
+			{ { 0, 7 }, { 4'000'000'000, 7 } },
+			{ { 1'000'000'000, 7 }, { 4'100'000'000, 7 } },
+			{ { 2'000'000'001, 0 }, { 2'000'000'001, 4'000'000'000 } },
+			{ { 7, 0 }, { 4'000'000'000, 3'999'999'993 } },
+			{ { 101, 3'000'000'000 }, { 3'000'000'101, 0 } },
+		};
+
+		// The vertical line crosses the diagonals at (2'000'000'001, 1'999'999'994) and
+		// (2'000'000'001, 1'000'000'100), and they cross each other at (1'500'000'054, 1'500'000'047).
+		// The first diagonal meets the collinear lines at x = 14, which only one of them covers; the
+		// second meets them at x = 3'000'000'094, and the vertical at x = 2'000'000'001, which both do.
+		Assert::AreEqual(uint64_t{ 3'000'000'001 + 4 },
+			Analyzer_t::score<Analyzer_t::horizontal | Analyzer_t::vertical | Analyzer_t::diagonal, Analyzer_t::Engine::sweep>(lines));
+	}
+
+	TEST_METHOD(SweepEngineScoresPastThirtyTwoBits)
+	{
+		using Analyzer_t = aoc::VentAnalyzer;
+		using Line_t = aoc::Line2d<uint32_t>;
+
+		// Two rows and a column, each covered twice end to end.
+		const auto lines = std::vector<Line_t>{
+			{ { 0, 0 }, { 4'000'000'000, 0 } },
+			{ { 4'000'000'000, 0 }, { 0, 0 } },
+			{ { 0, 1 }, { 4'000'000'000, 1 } },
+			{ { 4'000'000'000, 1 }, { 0, 1 } },
+			{ { 9, 0 }, { 9, 4'000'000'000 } },
+			{ { 9, 4'000'000'000 }, { 9, 0 } },
+		};
+
+		Assert::AreEqual(uint64_t{ 3 } * 4'000'000'001 - 2,
+			Analyzer_t::score<Analyzer_t::horizontal | Analyzer_t::vertical, Analyzer_t::Engine::sweep>(lines));
+	}
+
+	TEST_METHOD(SweepEngineIgnoresFarReachingNonDiagonalLines)
+	{
+		using Analyzer_t = aoc::VentAnalyzer;
+		using Line_t = aoc::Line2d<uint32_t>;
 
-		std::stringstream data{ data_str };
+		// The second line isn't diagonal, but its x and y distances agree modulo 2^32.
+		const auto lines = std::vector<Line_t>{
+			{ { 0, 0 }, { 3'000'000'000, 3'000'000'000 } },
+			{ { 0, 0 }, { 3'000'000'000, 1'294'967'296 } },
+		};
 
-		Assert::AreEqual(uint32_t{ 5 }, aoc::VentAnalyzer{ data }.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>());
+		Assert::AreEqual(uint64_t{ 0 }, Analyzer_t::score<Analyzer_t::diagonal, Analyzer_t::Engine::sweep>(lines));
 	}
-	TEST_METHOD(VentAnalyserScoresExampleDataWithDiagonals)
+
+	TEST_METHOD(VentAnalyserScoresLinesTooSpreadOutForAGrid)
 	{
-		constexpr auto data_str =
-			"0,9 -> 5,9\n"
-			"8,0 -> 0,8\n"
-			"9,4 -> 3,4\n"
-			"2,2 -> 2,1\n"
-			"7,0 -> 7,4\n"
-			"6,4 -> 2,0\n"
-			"0,9 -> 2,9\n"
-			"3,4 -> 1,4\n"
-			"0,0 -> 8,8\n"
-			"5,5 -> 8,2";
+		using Line_t = aoc::Line2d<uint32_t>;
 
-		std::stringstream data{ data_str };
+		auto lines = std::vector<Line_t>{ { { 0, 0 }, { 0, 5 } }, { { 0, 3 }, { 0, 9 } }, { { 0, 4 }, { 4, 4 } } };
+		Assert::AreEqual(uint32_t{ 3 }, aoc::VentAnalyzer::score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>(lines));
 
-		Assert::AreEqual(uint32_t{ 12 }, aoc::VentAnalyzer{ data }
-		.score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>());
+		lines.push_back({ { 1'000'000, 1'000'000 }, { 1'000'000, 1'000'001 } });
+		Assert::AreEqual(uint32_t{ 3 }, aoc::VentAnalyzer::score<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>(lines));
 	}
 };
 }
@@ -938,6 +2059,304 @@ public:
 
 		Assert::IsTrue(std::equal(expected.begin(), expected.end(), least_frequent_bits.begin()));
 	}
+
+	TEST_METHOD(ParallelBitCountsMatchSerialOnes)
+	{
+		auto text = std::string{};
+		auto random = TestRandom{ 777 };
+		for (auto i = 0; i < 300'001; ++i) {
+			// Skew every other column so the answer isn't all ties.
+			const auto value = ((random.next() >> 10) & 0xFFF) | (0 == i % 3 ? 0 : 0b101010101010);
+			for (auto bit = 11; bit >= 0; --bit) {
+				text += ((value >> bit) & 1) ? '1' : '0';
+			}
+			text += '\n';
+		}
+
+		std::stringstream ss(text);
+		const auto log = aoc::DiagnosticLog{ ss };
+
+		auto pool = aoc::ThreadPool{ 4 };
+		Assert::IsTrue(log.get_most_frequent_bits() == log.get_most_frequent_bits(pool));
+		Assert::IsTrue(log.get_least_frequent_bits() == log.get_least_frequent_bits(pool));
+
+		auto single_thread = aoc::ThreadPool{ 1 };
+		Assert::IsTrue(log.get_most_frequent_bits() == log.get_most_frequent_bits(single_thread));
+	}
+
+	TEST_METHOD(AppendingKeepsRunningCounts)
+	{
+		auto log = aoc::DiagnosticLog{};
+		log.append(aoc::DiagnosticLog::Entry_t{ 1,1,1,0,1,1,1,1,0,1,0,1 });
+		log.append("011000111010\n");
+
+		Assert::IsTrue(aoc::DiagnosticLog::Entry_t{ 1,1,1,0,1,1,1,1,1,1,1,1 } == log.get_most_frequent_bits());
+
+		const auto batch = std::vector<aoc::DiagnosticLog::Entry_t>{ { 1,0,0,0,0,0,0,1,0,0,1,0 }, { 1,0,0,0,0,0,0,1,0,0,1,0 } };
+		log.append(batch);
+		log.append(std::vector<uint64_t>{ 0b000000000000 });
+
+		std::stringstream ss("111011110101\n011000111010\n100000010010\n100000010010\n000000000000");
+		const auto loaded = aoc::DiagnosticLog{ ss };
+
+		Assert::AreEqual(loaded.size(), log.size());
+		Assert::IsTrue(loaded.get_most_frequent_bits() == log.get_most_frequent_bits());
+		Assert::IsTrue(loaded.get_least_frequent_bits() == log.get_least_frequent_bits());
+		Assert::AreEqual(aoc::LogProcessor::power_consumption(loaded), aoc::LogProcessor::power_consumption(log));
+
+		auto pool = aoc::ThreadPool{ 2 };
+		Assert::IsTrue(log.get_most_frequent_bits(pool) == log.get_most_frequent_bits());
+	}
+
+	TEST_METHOD(FailedAppendLeavesLogUnchanged)
+	{
+		auto log = aoc::DiagnosticLog{};
+		log.append("111011110101\n");
+
+		Assert::ExpectException<aoc::Exception>([&log]() { log.append("011000111010\n0110001110\n"); });
+
+		Assert::AreEqual(size_t{ 1 }, log.size());
+		Assert::IsTrue(aoc::DiagnosticLog::Entry_t{ 1,1,1,0,1,1,1,1,0,1,0,1 } == log.get_most_frequent_bits());
+	}
+
+	TEST_METHOD(EntriesAreBitPacked)
+	{
+		Assert::AreEqual(size_t{ 2 }, sizeof(aoc::DiagnosticLog::Entry_t));
+		Assert::AreEqual(size_t{ 4 }, sizeof(aoc::BasicDiagnosticLog<32>::Entry_t));
+		Assert::AreEqual(size_t{ 16 }, sizeof(aoc::BasicDiagnosticLog<128>::Entry_t));
+	}
+
+	TEST_METHOD(WideEntriesWork)
+	{
+		// 33 and 70 bits wide
+		std::stringstream narrow_ss("100000000000000000000000000000001\n"
+			"110000000000000000000000000000000\n"
+			"100000000000000000000000000000011\n");
+
+		const auto narrow_log = aoc::BasicDiagnosticLog<33>{ narrow_ss };
+		const auto narrow_bits = narrow_log.get_most_frequent_bits();
+
+		Assert::AreEqual((uint64_t{ 1 } << 32) | 1, aoc::BasicDiagnosticLog<33>::entry_as<uint64_t>(narrow_bits));
+		Assert::AreEqual((uint64_t{ 1 } << 32) - 2, aoc::BasicDiagnosticLog<33>::flipped_entry_as<uint64_t>(narrow_bits));
+
+		const auto one = std::string(69, '0') + "1";
+		const auto top = "1" + std::string(69, '0');
+		std::stringstream wide_ss(one + "\n" + top + "\n" + top + "\n");
+
+		const auto wide_log = aoc::BasicDiagnosticLog<70>{ wide_ss };
+		const auto wide_bits = wide_log.get_most_frequent_bits();
+
+		Assert::AreEqual(size_t{ 3 }, wide_log.size());
+		Assert::IsTrue(wide_bits[0]);
+		Assert::IsFalse(wide_bits[69]);
+		Assert::AreEqual(uint64_t{ 0 }, aoc::BasicDiagnosticLog<70>::entry_as<uint64_t>(wide_bits));
+		Assert::AreEqual(std::numeric_limits<uint64_t>::max(), aoc::BasicDiagnosticLog<70>::flipped_entry_as<uint64_t>(wide_bits));
+		Assert::IsTrue(wide_bits.flipped() == wide_log.get_least_frequent_bits());
+
+		std::stringstream bad_ss(one + "\n" + std::string(69, '1') + "2\n");
+		Assert::ExpectException<aoc::Exception>([&]() { aoc::BasicDiagnosticLog<70>{ bad_ss }; });
+	}
+};
+
+TEST_CLASS(PositionalPopcount)
+{
+public:
+	template<typename Word_T>
+	static void check_against_bit_by_bit_count(size_t word_count, size_t stride)
+	{
+		constexpr size_t bits = std::numeric_limits<Word_T>::digits;
+
+		auto words = std::vector<Word_T>(word_count);
+		auto state = uint64_t{ 0x9E3779B97F4A7C15 };
+		for (auto& word : words) {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			word = static_cast<Word_T>(state);
+		}
+
+		auto expected = std::vector<uint64_t>(stride * bits);
+		for (size_t i = 0; i < words.size(); ++i) {
+			for (size_t b = 0; b < bits; ++b) {
+				expected[(i % stride) * bits + b] += (words[i] >> b) & 1;
+			}
+		}
+
+		auto counts = std::vector<uint64_t>(stride * bits);
+		aoc::positional_popcount(std::span<const Word_T>{ words }, stride, counts);
+
+		Assert::IsTrue(expected == counts);
+	}
+
+	TEST_METHOD(MatchesBitByBitCount)
+	{
+		// Long enough to spill the 8-bit counters several times, with a ragged tail.
+		check_against_bit_by_bit_count<uint8_t>(40'001, 1);
+		check_against_bit_by_bit_count<uint16_t>(20'003, 1);
+		check_against_bit_by_bit_count<uint32_t>(10'007, 1);
+		check_against_bit_by_bit_count<uint64_t>(5'002, 2);
+		check_against_bit_by_bit_count<uint64_t>(3'003, 3);
+	}
+
+	TEST_METHOD(AddsToExistingCounts)
+	{
+		const auto words = std::vector<uint16_t>(100, uint16_t{ 0b101 });
+		auto counts = std::vector<uint64_t>(16, 1);
+
+		aoc::positional_popcount(std::span<const uint16_t>{ words }, 1, counts);
+
+		Assert::AreEqual(uint64_t{ 101 }, counts[0]);
+		Assert::AreEqual(uint64_t{ 1 }, counts[1]);
+		Assert::AreEqual(uint64_t{ 101 }, counts[2]);
+	}
+};
+
+TEST_CLASS(BitPlaneLog)
+{
+public:
+	TEST_METHOD(TransposeSwapsRowsAndColumns)
+	{
+		auto rows = std::array<uint64_t, 64>{};
+		for (size_t i = 0; i < rows.size(); ++i) {
+			rows[i] = (uint64_t{ 0x9E3779B97F4A7C15 } * (i + 1)) ^ (i << 40);
+		}
+
+		auto transposed = rows;
+		aoc::detail::transpose_64x64(transposed);
+
+		for (size_t i = 0; i < 64; ++i) {
+			for (size_t j = 0; j < 64; ++j) {
+				Assert::AreEqual((rows[j] >> i) & 1, (transposed[i] >> j) & 1);
+			}
+		}
+	}
+
+	TEST_METHOD(MatchesEntryLayoutOnLargeLogs)
+	{
+		// Enough entries for the bit-plane path, and a ragged last plane word.
+		auto text = std::string{};
+		auto state = uint32_t{ 12345 };
+		for (auto i = 0; i < 5'001; ++i) {
+			state = state * 1103515245 + 12345;
+			const auto value = (state >> 8) & 0xFFF;
+			for (auto bit = 11; bit >= 0; --bit) {
+				text += ((value >> bit) & 1) ? '1' : '0';
+			}
+			text += '\n';
+		}
+
+		std::stringstream ss(text);
+		const auto log = aoc::DiagnosticLog{ ss };
+		const auto planes = aoc::BitPlaneLog{ log };
+
+		Assert::AreEqual(log.size(), planes.size());
+		Assert::IsTrue(log.get_most_frequent_bits() == planes.get_most_frequent_bits());
+		Assert::IsTrue(log.get_least_frequent_bits() == planes.get_least_frequent_bits());
+
+		const auto life_support = aoc::LifeSupport{ log };
+		Assert::AreEqual(life_support.filter_using_most_frequent_bits(), planes.filter_using_most_frequent_bits());
+		Assert::AreEqual(life_support.filter_using_least_frequent_bits(), planes.filter_using_least_frequent_bits());
+		Assert::AreEqual(life_support.rating(), aoc::LogProcessor::life_support_rating(log));
+	}
+
+	TEST_METHOD(SharedBitsAndDuplicatesKeepSurvivors)
+	{
+		std::stringstream ss("000000000011\n000000000001\n000000000101\n000000000101");
+		const auto planes = aoc::BitPlaneLog{ aoc::DiagnosticLog{ ss } };
+
+		Assert::AreEqual(uint32_t{ 0b101 }, planes.filter_using_most_frequent_bits());
+		Assert::AreEqual(uint32_t{ 0b1 }, planes.filter_using_least_frequent_bits());
+	}
+};
+
+TEST_CLASS(BitLineDecoder)
+{
+public:
+
+	static std::string make_bit_lines(size_t width, size_t count, std::vector<uint64_t>& values, std::string_view line_ending = "\n")
+	{
+		auto text = std::string{};
+		for (size_t line = 0; line < count; ++line) {
+			auto value = uint64_t{ 0 };
+			for (size_t bit = 0; bit < width; ++bit) {
+				const auto set = 0 != ((line * 2654435761u + bit * 40503u) >> 7 & 1);
+				text += set ? '1' : '0';
+				value = (value << 1) | (set ? 1 : 0);
+			}
+
+			text += line_ending;
+			values.push_back(value);
+		}
+
+		return text;
+	}
+
+	TEST_METHOD(DecodesLinesOfEveryWidth)
+	{
+		for (const auto width : { 1, 7, 12, 31, 32, 33, 63, 64 }) {
+			auto expected = std::vector<uint64_t>{};
+			const auto text = make_bit_lines(width, 1000, expected);
+
+			const auto decoded = aoc::BitLineDecoder{ static_cast<size_t>(width) }.decode(text);
+
+			Assert::IsTrue(decoded.has_value());
+			Assert::IsTrue(expected == *decoded);
+		}
+	}
+
+	TEST_METHOD(DecodesCrlfLinesOfEveryWidth)
+	{
+		// Long enough runs of well-formed lines for the blocks to be decoded whole.
+		for (const auto width : { 1, 7, 12, 31, 32, 33, 63, 64 }) {
+			auto expected = std::vector<uint64_t>{};
+			const auto text = make_bit_lines(width, 1000, expected, "\r\n");
+
+			const auto decoded = aoc::BitLineDecoder{ static_cast<size_t>(width) }.decode(text);
+
+			Assert::IsTrue(decoded.has_value());
+			Assert::IsTrue(expected == *decoded);
+		}
+	}
+
+	TEST_METHOD(ReportsOffsetOfStrayCharacterBeforeCrlf)
+	{
+		auto values = std::vector<uint64_t>{};
+		auto text = make_bit_lines(12, 100, values, "\r\n");
+		text[14 * 10 + 12] = '1';
+
+		const auto decoded = aoc::BitLineDecoder{ 12 }.decode(text);
+
+		Assert::IsFalse(decoded.has_value());
+		Assert::AreEqual(size_t{ 14 * 10 }, decoded.error().offset);
+	}
+
+	TEST_METHOD(AcceptsCrlfAndBlankLines)
+	{
+		const auto decoded = aoc::BitLineDecoder{ 4 }.decode("1010\r\n\r\n0111\n\n1111");
+
+		Assert::IsTrue(decoded.has_value());
+		Assert::IsTrue(std::vector<uint64_t>{ 0b1010, 0b0111, 0b1111 } == *decoded);
+	}
+
+	TEST_METHOD(ReportsOffsetOfInvalidCharacter)
+	{
+		auto values = std::vector<uint64_t>{};
+		auto text = make_bit_lines(12, 100, values);
+		text[13 * 10 + 5] = '2';
+
+		const auto decoded = aoc::BitLineDecoder{ 12 }.decode(text);
+
+		Assert::IsFalse(decoded.has_value());
+		Assert::AreEqual(size_t{ 13 * 10 + 5 }, decoded.error().offset);
+	}
+
+	TEST_METHOD(ReportsOffsetOfLineWithWrongWidth)
+	{
+		const auto decoded = aoc::BitLineDecoder{ 4 }.decode("1010\n01110\n1111");
+
+		Assert::IsFalse(decoded.has_value());
+		Assert::AreEqual(size_t{ 5 }, decoded.error().offset);
+	}
 };
 }
 
@@ -959,6 +2378,18 @@ public:
 		Assert::IsTrue(std::equal(expected_draws.begin(), expected_draws.end(), draws.begin()));
 	}
 
+	TEST_METHOD(LoadExampleDrawsVectorized)
+	{
+		std::stringstream ss{ "7, 4, 9, 5\n" };
+
+		auto draws = aoc::bingo::FileBasedNumberDrawer<uint8_t>{};
+
+		draws.load(ss, aoc::ParseStrategy::vectorized);
+
+		const auto expected_draws = { 7, 4, 9, 5 };
+		Assert::IsTrue(std::equal(expected_draws.begin(), expected_draws.end(), draws.begin(), draws.end()));
+	}
+
 	TEST_METHOD(BoardIdReturnsCorrectId)
 	{
 		Assert::AreEqual(aoc::bingo::Board::Id_t{ 10 }, aoc::bingo::Board{ 10, 3 }.id());
@@ -1189,6 +2620,13 @@ public:
 		Assert::IsTrue(data.fail());
 	}
 
+	TEST_METHOD(VectorizedReadingOfShoalWithTooLongSpawningTimeRaisesAocException)
+	{
+		std::stringstream data("3,4,9,1,2");
+		Assert::ExpectException<aoc::Exception>([&data]() { aoc::LanternfishShoal{}.load(data, aoc::ParseStrategy::vectorized); });
+		Assert::IsTrue(data.fail());
+	}
+
 	TEST_METHOD(ExampleShoalIsCorrectAfter18Days)
 	{
 		std::stringstream data("3,4,3,1,2");
@@ -1246,6 +2684,22 @@ public:
 
 		Assert::AreEqual(uint32_t{ 1538 }, depth_score);
 	}
+
+	TEST_METHOD(DepthScoresFromMappedFile)
+	{
+		const auto buffer = aoc::InputBuffer{ DATA_DIR / "Day1_input.txt" };
+
+		Assert::AreEqual(uint32_t{ 1502 }, aoc::Submarine().boat_systems().depth_score<1>(buffer));
+		Assert::AreEqual(uint32_t{ 1538 }, aoc::Submarine().boat_systems().depth_score<3>(buffer));
+	}
+
+	TEST_METHOD(BothScoresFromOnePass)
+	{
+		const auto window_sizes = std::vector<size_t>{ 1, 3 };
+		const auto scores = aoc::Submarine().boat_systems().depth_scores(aoc::InputBuffer{ DATA_DIR / "Day1_input.txt" }, window_sizes);
+
+		Assert::IsTrue(std::vector<uint32_t>{ 1502, 1538 } == scores);
+	}
 };
 }
 
@@ -1267,6 +2721,24 @@ public:
 		Assert::AreEqual(1895, net_direction.x);
 		Assert::AreEqual(894, net_direction.y);
 	}
+
+	TEST_METHOD(ParseDirectionsFromMappedFile)
+	{
+		const auto buffer = aoc::InputBuffer{ DATA_DIR / "Day2_input.txt" };
+
+		const auto net_direction = aoc::Submarine().boat_systems().net_direction(buffer);
+		Assert::AreEqual(1895, net_direction.x);
+		Assert::AreEqual(894, net_direction.y);
+
+		std::ifstream data_file(DATA_DIR / "Day2_input.txt");
+		Assert::IsTrue(data_file.is_open());
+
+		using StreamIter_t = std::istream_iterator<aoc::Direction>;
+		const auto expected_aiming = aoc::Submarine().boat_systems().net_aiming(StreamIter_t(data_file), StreamIter_t());
+		const auto net_aiming = aoc::Submarine().boat_systems().net_aiming(buffer);
+
+		Assert::IsTrue(expected_aiming == net_aiming);
+	}
 };
 }
 
@@ -1298,6 +2770,22 @@ public:
 
 		Assert::AreEqual(uint32_t{ 3379326 }, aoc::Submarine().boat_systems().life_support_rating(log));
 	}
+
+	TEST_METHOD(LoadLogFromMappedFile)
+	{
+		const auto log = aoc::DiagnosticLog{ aoc::InputBuffer{ DATA_DIR / "Day3_input.txt" } };
+
+		Assert::AreEqual(uint32_t{ 693486 }, aoc::Submarine().boat_systems().power_consumption(log));
+		Assert::AreEqual(uint32_t{ 3379326 }, aoc::Submarine().boat_systems().life_support_rating(log));
+	}
+
+	TEST_METHOD(BitPlaneLogGivesTheSameAnswers)
+	{
+		const auto log = aoc::BitPlaneLog{ aoc::InputBuffer{ DATA_DIR / "Day3_input.txt" } };
+
+		Assert::AreEqual(uint32_t{ 693486 }, aoc::Submarine().boat_systems().power_consumption(log));
+		Assert::AreEqual(uint32_t{ 3379326 }, aoc::Submarine().boat_systems().life_support_rating(log));
+	}
 };
 }
 
@@ -1403,6 +2891,24 @@ public:
 		Assert::IsTrue(std::nullopt != game_score);
 		Assert::AreEqual(uint32_t{ 6594 }, *game_score);
 	}
+
+	TEST_METHOD(FindScoresForMappedFile)
+	{
+		const auto buffer = aoc::InputBuffer{ DATA_DIR / "Day4_input.txt" };
+
+		const auto winning_score = aoc::Submarine().entertainment().bingo_game()
+			.load(buffer)
+			.play_to_win()
+			.score();
+
+		const auto losing_score = aoc::Submarine().entertainment().bingo_game()
+			.load(buffer)
+			.play_to_lose()
+			.score();
+
+		Assert::AreEqual(uint32_t{ 2745 }, *winning_score);
+		Assert::AreEqual(uint32_t{ 6594 }, *losing_score);
+	}
 };
 }
 
@@ -1437,6 +2943,28 @@ public:
 			Assert::AreEqual(uint32_t{ 20196 }, vent_score);
 		}
 	}
+
+	TEST_METHOD(FindVentScoresForMappedFile)
+	{
+		const auto buffer = aoc::InputBuffer{ DATA_DIR / "Day5_input.txt" };
+
+		Assert::AreEqual(uint32_t{ 6267 }, aoc::Submarine()
+			.boat_systems()
+			.detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical>(buffer));
+
+		Assert::AreEqual(uint32_t{ 20196 }, aoc::Submarine()
+			.boat_systems()
+			.detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>(buffer));
+	}
+
+	TEST_METHOD(SweepEngineGivesTheSameScores)
+	{
+		using Analyzer_t = aoc::VentAnalyzer;
+		const auto analyzer = Analyzer_t{ aoc::InputBuffer{ DATA_DIR / "Day5_input.txt" } };
+
+		Assert::AreEqual(uint64_t{ 6267 }, analyzer.score<Analyzer_t::horizontal | Analyzer_t::vertical, Analyzer_t::Engine::sweep>());
+		Assert::AreEqual(uint64_t{ 20196 }, analyzer.score<Analyzer_t::horizontal | Analyzer_t::vertical | Analyzer_t::diagonal, Analyzer_t::Engine::sweep>());
+	}
 };
 }
 
@@ -1468,6 +2996,39 @@ public:
 
 		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 1632146183902 }, number_of_fish);
 	}
+
+	TEST_METHOD(FindFishCountForFullInputWithVectorizedParsing)
+	{
+		std::ifstream data_file(DATA_DIR / "Day6_input.txt");
+		Assert::IsTrue(data_file.is_open());
+
+		auto shoal = aoc::LanternfishShoal{}.load(data_file, aoc::ParseStrategy::vectorized);
+
+		const auto number_of_fish = aoc::LanternfishShoalModel{ shoal }.run_for(std::chrono::days(256)).shoal_size();
+
+		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 1632146183902 }, number_of_fish);
+	}
+
+	TEST_METHOD(ModelCanBeLoadedStraightFromStream)
+	{
+		std::ifstream data_file(DATA_DIR / "Day6_input.txt");
+		Assert::IsTrue(data_file.is_open());
+
+		const auto number_of_fish = aoc::LanternfishShoalModel{ data_file }.run_for(std::chrono::days(80)).shoal_size();
+
+		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 360268 }, number_of_fish);
+	}
+
+	TEST_METHOD(ShoalAndModelCanBeLoadedFromMappedFile)
+	{
+		const auto buffer = aoc::InputBuffer{ DATA_DIR / "Day6_input.txt" };
+
+		auto shoal = aoc::LanternfishShoal{};
+		shoal.load(buffer, aoc::ParseStrategy::vectorized);
+
+		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 360268 }, aoc::LanternfishShoalModel{ shoal }.run_for(std::chrono::days(80)).shoal_size());
+		Assert::AreEqual(aoc::LanternfishShoal::Size_t{ 1632146183902 }, aoc::LanternfishShoalModel{ buffer }.run_for(std::chrono::days(256)).shoal_size());
+	}
 };
 }
 
@@ -1486,6 +3047,13 @@ public:
 		Assert::IsTrue(std::equal(expected_positions.begin(), expected_positions.end(), sorter.positions().begin()));
 	}
 
+	TEST_METHOD(ReadingCrabPositionsFromMalformedStringRaisesAocException)
+	{
+		std::stringstream data("16,1,2,X,4");
+		Assert::ExpectException<aoc::Exception>([&data]() { aoc::CrabSorter{}.load(data); });
+		Assert::IsTrue(data.fail());
+	}
+
 	TEST_METHOD(CalculateBestPosition)
 	{
 		std::stringstream data("16,1,2,0,4,2,7,1,2,14");
@@ -1507,6 +3075,30 @@ public:
 		Assert::AreEqual(uint32_t{ 329389 }, cost);
 	}
 
+	TEST_METHOD(VectorizedLoadingMatchesTokenizedLoading)
+	{
+		std::ifstream tokenized_file(DATA_DIR / "Day7_input.txt");
+		std::ifstream vectorized_file(DATA_DIR / "Day7_input.txt");
+		Assert::IsTrue(tokenized_file.is_open() && vectorized_file.is_open());
+
+		const auto tokenized = aoc::CrabSorter{}.load(tokenized_file).positions();
+		const auto vectorized = aoc::CrabSorter{}.load(vectorized_file, aoc::ParseStrategy::vectorized).positions();
+
+		Assert::IsTrue(tokenized == vectorized);
+	}
+
+	TEST_METHOD(LoadCrabPositionsFromMappedFile)
+	{
+		const auto buffer = aoc::InputBuffer{ DATA_DIR / "Day7_input.txt" };
+
+		const auto [best_position, cost] = aoc::CrabSorter{}
+			.load(buffer)
+			.best_position_and_cost([](uint32_t distance) { return distance; });
+
+		Assert::AreEqual(size_t{ 330 }, best_position);
+		Assert::AreEqual(uint32_t{ 329389 }, cost);
+	}
+
 	TEST_METHOD(CalculateBestPositionForAllInputWithQuadraticCost)
 	{
 		std::ifstream data_file(DATA_DIR / "Day7_input.txt");
@@ -0,0 +1,307 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Bit i of each mask describes byte i of a 64-byte chunk of text.
+struct BitLineMasks
+{
+	uint64_t ones;
+	uint64_t digits;
+	uint64_t returns;
+	uint64_t newlines;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Bit i is set when byte i of the (little-endian) word equals c.
+inline uint32_t swar_equal_mask(uint64_t word, char c)
+{
+	const auto diff = word ^ (0x0101010101010101 * static_cast<uint8_t>(c));
+	const auto zero_bytes = ~(((diff & 0x7F7F7F7F7F7F7F7F) + 0x7F7F7F7F7F7F7F7F) | diff | 0x7F7F7F7F7F7F7F7F);
+
+	return static_cast<uint32_t>(((zero_bytes >> 7) * 0x0102040810204080) >> 56);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline BitLineMasks classify_bit_chunk(const char* chunk)
+{
+	auto out = BitLineMasks{};
+
+#if defined(AOC_HAVE_AVX2)
+	for (auto half = 0; half < 2; ++half) {
+		const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk + 32 * half));
+		const auto ones = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('1'));
+		const auto zeros = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('0'));
+		const auto returns = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'));
+		const auto newlines = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'));
+
+		const auto shift = 32 * half;
+		out.ones |= uint64_t{ static_cast<uint32_t>(_mm256_movemask_epi8(ones)) } << shift;
+		out.digits |= uint64_t{ static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(ones, zeros))) } << shift;
+		out.returns |= uint64_t{ static_cast<uint32_t>(_mm256_movemask_epi8(returns)) } << shift;
+		out.newlines |= uint64_t{ static_cast<uint32_t>(_mm256_movemask_epi8(newlines)) } << shift;
+	}
+#elif defined(AOC_HAVE_SSE2)
+	for (auto quarter = 0; quarter < 4; ++quarter) {
+		const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk + 16 * quarter));
+		const auto ones = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('1'));
+		const auto zeros = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('0'));
+		const auto returns = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'));
+		const auto newlines = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'));
+
+		const auto shift = 16 * quarter;
+		out.ones |= uint64_t{ static_cast<uint32_t>(_mm_movemask_epi8(ones)) } << shift;
+		out.digits |= uint64_t{ static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(ones, zeros))) } << shift;
+		out.returns |= uint64_t{ static_cast<uint32_t>(_mm_movemask_epi8(returns)) } << shift;
+		out.newlines |= uint64_t{ static_cast<uint32_t>(_mm_movemask_epi8(newlines)) } << shift;
+	}
+#else
+	for (auto eighth = 0; eighth < 8; ++eighth) {
+		auto word = uint64_t{};
+		std::memcpy(&word, chunk + 8 * eighth, sizeof(word));
+
+		const auto shift = 8 * eighth;
+		const auto ones = swar_equal_mask(word, '1');
+		out.ones |= uint64_t{ ones } << shift;
+		out.digits |= uint64_t{ ones | swar_equal_mask(word, '0') } << shift;
+		out.returns |= uint64_t{ swar_equal_mask(word, '\r') } << shift;
+		out.newlines |= uint64_t{ swar_equal_mask(word, '\n') } << shift;
+	}
+#endif
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline uint64_t reverse_bits(uint64_t value)
+{
+	value = ((value >> 1) & 0x5555555555555555) | ((value & 0x5555555555555555) << 1);
+	value = ((value >> 2) & 0x3333333333333333) | ((value & 0x3333333333333333) << 2);
+	value = ((value >> 4) & 0x0F0F0F0F0F0F0F0F) | ((value & 0x0F0F0F0F0F0F0F0F) << 4);
+
+	return std::byteswap(value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Decodes lines of exactly `width` '0'/'1' characters (1 to 64 of them) into packed words, with
+// the first character of a line as the most significant bit. Well-formed runs of lines are
+// decoded 256 bytes, so up to 128 lines, at a time: the block is classified with SIMD compares
+// (or SWAR), validated with a single compare against the expected layout, and the lines are then
+// cut out of the resulting bitmask. The layout has the line ending of the text's first line,
+// "\n" or "\r\n". Anything else (blank lines, mixed line endings, the tail of the text) goes
+// through a per-line SWAR decoder, which also pinpoints malformed input.
+class BitLineDecoder
+{
+public:
+	static constexpr size_t max_width = 64;
+
+	explicit BitLineDecoder(size_t width)
+		: _width{ width }
+	{
+		if (0 == width || width > max_width) {
+			throw Exception(std::format("Bit line width must be between 1 and {}", max_width));
+		}
+
+		for (const auto crlf : { false, true }) {
+			auto& layout = _layouts[crlf];
+			layout.stride = width + (crlf ? 2 : 1);
+			layout.lines_per_block = block_size / layout.stride;
+
+			for (size_t i = 0; i < layout.lines_per_block * layout.stride; ++i) {
+				const auto column = i % layout.stride;
+				auto& mask = column < width ? layout.expected_digits : layout.stride - 1 == column ? layout.expected_newlines : layout.expected_returns;
+				mask[i / 64] |= uint64_t{ 1 } << (i % 64);
+			}
+		}
+	}
+
+	size_t width() const { return _width; }
+
+	// Calls sink(value) for each line of text, in order.
+	template<typename Sink_T>
+	std::expected<void, ParseError> for_each(std::string_view text, Sink_T&& sink) const
+	{
+		const auto begin = text.data();
+		const auto end = begin + text.size();
+		const auto& layout = _layout_of(text);
+
+		auto pos = begin;
+		auto scalar_until = begin;
+		while (pos != end) {
+			if (pos >= scalar_until && end - pos >= static_cast<ptrdiff_t>(block_size)) {
+				if (_decode_block(layout, pos, sink)) {
+					pos += layout.lines_per_block * layout.stride;
+					continue;
+				}
+
+				// Not a run of well-formed lines; let the line decoder deal with this block.
+				scalar_until = pos + block_size;
+			}
+
+			const auto error = _decode_line(begin, pos, end, sink);
+			if (std::errc{} != error.error)
+				return std::unexpected(error);
+		}
+
+		return {};
+	}
+
+	std::expected<std::vector<uint64_t>, ParseError> decode(std::string_view text) const
+	{
+		auto out = std::vector<uint64_t>{};
+		out.reserve(text.size() / (_width + 1) + 1);
+
+		const auto result = for_each(text, [&out](uint64_t value) { out.push_back(value); });
+		if (!result)
+			return std::unexpected(result.error());
+
+		return out;
+	}
+
+private:
+
+	static constexpr size_t block_size = 256;
+	static constexpr size_t words_per_block = block_size / 64;
+
+	// Where a block of well-formed lines has its digits and line endings.
+	struct Layout
+	{
+		size_t stride;
+		size_t lines_per_block;
+		std::array<uint64_t, words_per_block> expected_digits{};
+		std::array<uint64_t, words_per_block> expected_returns{};
+		std::array<uint64_t, words_per_block> expected_newlines{};
+	};
+
+	const Layout& _layout_of(std::string_view text) const
+	{
+		const auto newline = text.find('\n');
+		const auto crlf = std::string_view::npos != newline && 0 != newline && '\r' == text[newline - 1];
+
+		return _layouts[crlf];
+	}
+
+	uint64_t _mask() const
+	{
+		return max_width == _width ? ~uint64_t{ 0 } : (uint64_t{ 1 } << _width) - 1;
+	}
+
+	template<typename Sink_T>
+	bool _decode_block(const Layout& layout, const char* block, Sink_T& sink) const
+	{
+		auto ones = std::array<uint64_t, words_per_block + 1>{};
+		auto mismatches = uint64_t{ 0 };
+
+		for (size_t word = 0; word < words_per_block; ++word) {
+			const auto masks = detail::classify_bit_chunk(block + 64 * word);
+
+			ones[word] = masks.ones;
+			mismatches |= ((masks.digits ^ layout.expected_digits[word]) | (masks.returns ^ layout.expected_returns[word])
+				| (masks.newlines ^ layout.expected_newlines[word]))
+				& (layout.expected_digits[word] | layout.expected_returns[word] | layout.expected_newlines[word]);
+		}
+
+		if (0 != mismatches)
+			return false;
+
+		for (size_t line = 0; line < layout.lines_per_block; ++line) {
+			const auto bit = line * layout.stride;
+			const auto shift = bit % 64;
+
+			auto bits = ones[bit / 64] >> shift;
+			if (0 != shift) {
+				bits |= ones[bit / 64 + 1] << (64 - shift);
+			}
+
+			sink(detail::reverse_bits(bits & _mask()) >> (max_width - _width));
+		}
+
+		return true;
+	}
+
+	template<typename Sink_T>
+	ParseError _decode_line(const char* begin, const char*& pos, const char* end, Sink_T& sink) const
+	{
+		while (pos != end && ('\n' == *pos || '\r' == *pos))
+			++pos;
+
+		if (pos == end)
+			return {};
+
+		const auto line_begin = pos;
+		auto line_end = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+		pos = line_end ? line_end + 1 : end;
+		line_end = line_end ? line_end : end;
+
+		if (line_end != line_begin && '\r' == *(line_end - 1))
+			--line_end;
+
+		auto value = uint64_t{ 0 };
+		for (auto chunk = line_begin; chunk < line_end; chunk += 8) {
+			const auto length = std::min<size_t>(8, line_end - chunk);
+
+			auto word = uint64_t{ 0x3030303030303030 };
+			std::memcpy(&word, chunk, length);
+
+			if ((word & 0xFEFEFEFEFEFEFEFE) != 0x3030303030303030) {
+				const auto bad = std::find_if(chunk, chunk + length, [](char c) { return '0' != c && '1' != c; });
+				return { static_cast<size_t>(bad - begin), std::errc::invalid_argument };
+			}
+
+			// Gathers the low bit of each byte, first byte first.
+			const auto bits = ((word & 0x0101010101010101) * 0x8040201008040201) >> 56;
+			value = (value << length) | (bits >> (8 - length));
+		}
+
+		if (static_cast<size_t>(line_end - line_begin) != _width) {
+			return { static_cast<size_t>(line_begin - begin), std::errc::invalid_argument };
+		}
+
+		sink(value);
+
+		return {};
+	}
+
+	size_t _width;
+	std::array<Layout, 2> _layouts{};	// "\n", then "\r\n"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,205 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+#include "InputBuffer.hpp"
+#include "BitLineDecoder.hpp"
+#include "DiagnosticLog.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// In place: afterwards bit j of rows[i] is what bit i of rows[j] was.
+inline void transpose_64x64(std::array<uint64_t, 64>& rows)
+{
+	auto mask = uint64_t{ 0x00000000FFFFFFFF };
+	for (size_t j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+		for (size_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+			const auto t = ((rows[k] >> j) ^ rows[k | j]) & mask;
+			rows[k] ^= t << j;
+			rows[k | j] ^= t;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A diagnostic log stored column-major: one dense bitset ("plane") per bit position, with bit j of
+// a plane belonging to entry j. Bit frequencies are then popcounts of the planes, and the
+// life-support filters narrow a candidate mask by ANDing in planes or their complements, so
+// neither ever touches an individual entry. Entries are transposed into planes 64 at a time.
+template<size_t ENTRY_WIDTH>
+	requires (ENTRY_WIDTH > 0 && ENTRY_WIDTH <= 64)
+class BasicBitPlaneLog
+{
+public:
+	static constexpr uint32_t entry_size = static_cast<uint32_t>(ENTRY_WIDTH);
+	using Log_t = BasicDiagnosticLog<ENTRY_WIDTH>;
+	using Entry_t = typename Log_t::Entry_t;
+
+	explicit BasicBitPlaneLog(const Log_t& log)
+	{
+		_load([&log](auto&& append) {
+			for (const auto& entry : log) {
+				append(entry.template as<uint64_t>());
+			}
+			});
+	}
+
+	explicit BasicBitPlaneLog(const InputBuffer& buffer)
+	{
+		_load([&buffer](auto&& append) {
+			const auto result = BitLineDecoder{ ENTRY_WIDTH }.for_each(buffer.view(), append);
+			if (!result)
+				throw Exception(std::format("Invalid log line at byte offset {}", result.error().offset));
+			});
+	}
+
+	size_t size() const { return _size; }
+
+	Entry_t get_most_frequent_bits() const
+	{
+		auto out = Entry_t{};
+		for (size_t position = 0; position < ENTRY_WIDTH; ++position) {
+			const auto ones = std::accumulate(_planes[position].begin(), _planes[position].end(), size_t{ 0 }, [](size_t count, uint64_t word) {
+				return count + std::popcount(word);
+				});
+
+			out.set(position, 2 * ones >= _size);
+		}
+
+		return out;
+	}
+
+	Entry_t get_least_frequent_bits() const
+	{
+		return get_most_frequent_bits().flipped();
+	}
+
+	uint32_t filter_using_most_frequent_bits() const
+	{
+		return Log_t::template entry_as<uint32_t>(_filter(true));
+	}
+
+	uint32_t filter_using_least_frequent_bits() const
+	{
+		return Log_t::template entry_as<uint32_t>(_filter(false));
+	}
+
+	uint32_t rating() const
+	{
+		return filter_using_most_frequent_bits() * filter_using_least_frequent_bits();
+	}
+
+private:
+
+	template<typename ForEachPacked_T>
+	void _load(ForEachPacked_T&& for_each_packed)
+	{
+		auto block = std::array<uint64_t, 64>{};
+		auto in_block = size_t{ 0 };
+
+		auto flush = [&]() {
+			detail::transpose_64x64(block);
+			for (size_t position = 0; position < ENTRY_WIDTH; ++position) {
+				_planes[position].push_back(block[position]);
+			}
+
+			block.fill(0);
+			in_block = 0;
+		};
+
+		for_each_packed([&](uint64_t packed_entry) {
+			block[in_block++] = packed_entry;
+			++_size;
+
+			if (block.size() == in_block)
+				flush();
+			});
+
+		if (0 != in_block)
+			flush();
+	}
+
+	// Same rules as LifeSupport: most common keeps 1 on ties, least common keeps 0, and a bit that
+	// all the candidates share doesn't filter any of them out.
+	Entry_t _filter(bool most_common) const
+	{
+		if (0 == _size) {
+			throw Exception("Can't filter an empty diagnostic log");
+		}
+
+		auto candidates = std::vector<uint64_t>(_planes[0].size(), ~uint64_t{ 0 });
+		if (0 != _size % 64) {
+			candidates.back() = (uint64_t{ 1 } << (_size % 64)) - 1;
+		}
+
+		auto count = _size;
+		for (size_t bit = 0; bit < ENTRY_WIDTH && count > 1; ++bit) {
+			const auto& plane = _planes[ENTRY_WIDTH - 1 - bit];
+
+			auto ones = size_t{ 0 };
+			for (size_t w = 0; w < candidates.size(); ++w) {
+				ones += std::popcount(candidates[w] & plane[w]);
+			}
+
+			const auto zeros = count - ones;
+			const auto keep_ones = most_common ? ones >= zeros : ones < zeros;
+
+			if (keep_ones && 0 != ones) {
+				std::transform(candidates.begin(), candidates.end(), plane.begin(), candidates.begin(), [](uint64_t c, uint64_t p) { return c & p; });
+				count = ones;
+			}
+			else if (0 != zeros) {
+				std::transform(candidates.begin(), candidates.end(), plane.begin(), candidates.begin(), [](uint64_t c, uint64_t p) { return c & ~p; });
+				count = zeros;
+			}
+		}
+
+		const auto word = std::find_if(candidates.begin(), candidates.end(), [](uint64_t c) { return 0 != c; });
+		const auto index = static_cast<size_t>(word - candidates.begin()) * 64 + std::countr_zero(*word);
+
+		auto out = Entry_t{};
+		for (size_t position = 0; position < ENTRY_WIDTH; ++position) {
+			out.set(position, 0 != ((_planes[position][index / 64] >> (index % 64)) & 1));
+		}
+
+		return out;
+	}
+
+	std::array<std::vector<uint64_t>, ENTRY_WIDTH> _planes;
+	size_t _size{ 0 };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+using BitPlaneLog = BasicBitPlaneLog<DiagnosticLog::entry_size>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -4,12 +4,28 @@
 
 #include "Common.hpp"
 #include "DiagnosticLog.hpp"
+#include "BitPlaneLog.hpp"
+#include "InputBuffer.hpp"
+#include "Line2dScanner.hpp"
+#include "DirectionColumns.hpp"
+#include "DepthWindows.hpp"
+#include "FormatScanner.hpp"
+#include "StreamingInput.hpp"
+#include "OverlapGrid.hpp"
+#include "OverlapSweep.hpp"
 
 #include <algorithm>
+#include <array>
 #include <vector>
 #include <format>
 #include <istream>
+#include <iterator>
+#include <string>
 #include <map>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <span>
 #include <bitset>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -19,71 +35,52 @@ namespace aoc
 
 ///////////////////////////////////////////////////////////////////////////////
 
-using Direction = Vec2d<int>;
-
-///////////////////////////////////////////////////////////////////////////////
-
-struct Aiming
+// Parses a "forward|up|down <n>" command
+inline std::expected<Direction, std::errc> parse_direction(std::string_view str)
 {
-	int x{};
-	int aim{};
-	int depth{};
+	constexpr auto x_signs = std::array<int, 3>{ 1, 0, 0 };
+	constexpr auto y_signs = std::array<int, 3>{ 0, -1, 1 };
 
-	Direction to_direction() const
-	{
-		return { x, depth };
-	}
+	const auto parsed = FormatScanner<"{word:forward|up|down} {i32}">::scan(str);
+	if (!parsed)
+		return std::unexpected(parsed.error().error);
 
-	Aiming operator+(const Direction& d) const
-	{
-		const auto new_aim = this->aim + d.y;
-		return {
-			this->x + d.x,
-			new_aim,
-			this->depth + d.x * new_aim
-		};
-	}
-};
+	const auto [command, magnitude] = *parsed;
+	return Direction{ x_signs[command] * magnitude, y_signs[command] * magnitude };
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Indexes the log once, as its entries sorted by value. The entries that share a prefix are then a
+// contiguous range of the index, and the boundary between the ones that continue with 0 and those
+// that continue with 1 is found by binary search, so each rating takes O(bits * log n) and nothing
+// is copied after construction.
 class LifeSupport
 {
 public:
-	LifeSupport(const DiagnosticLog& log) : _log(log) {}
+	using Entry_t = DiagnosticLog::Entry_t;
 
-	static uint32_t score_entry(const DiagnosticLog::Entry_t& entry, const DiagnosticLog::Entry_t& target)
+	LifeSupport(const DiagnosticLog& log)
+		: _sorted_entries(log.begin(), log.end())
 	{
-		return static_cast<uint32_t>(std::distance(entry.begin(), std::mismatch(entry.begin(), entry.end(), target.begin()).first));
+		std::sort(_sorted_entries.begin(), _sorted_entries.end(), [](const Entry_t& a, const Entry_t& b) {
+			return DiagnosticLog::entry_as<uint32_t>(a) < DiagnosticLog::entry_as<uint32_t>(b);
+			});
 	}
 
-	template<typename BitSelector_T>
-	uint32_t filter_bits_matching(BitSelector_T bit_selector) const
+	static uint32_t score_entry(const Entry_t& entry, const Entry_t& target)
 	{
-		auto entries = std::vector<DiagnosticLog::Entry_t>(_log.begin(), _log.end());
-
-		auto curr_bit_idx = uint32_t{ 0 };
-		auto end = entries.end();
-		while (std::distance(entries.begin(), end) > 1) {
-			auto bits_to_match = bit_selector(entries.begin(), end);
-			end = std::remove_if(entries.begin(), end, [&bits_to_match, curr_bit_idx](auto e) {
-				return e[curr_bit_idx] != bits_to_match[curr_bit_idx];
-				});
-
-			++curr_bit_idx;
-		}
-
-		return DiagnosticLog::entry_as<uint32_t>(entries.front());
+		return static_cast<uint32_t>(std::distance(entry.begin(), std::mismatch(entry.begin(), entry.end(), target.begin()).first));
 	}
 
 	uint32_t filter_using_most_frequent_bits() const
 	{
-		return filter_bits_matching(DiagnosticLog::most_frequent_bits<DiagnosticLog::Iterator_t>);
+		return _filter(Keep::most_common);
 	}
 
 	uint32_t filter_using_least_frequent_bits() const
 	{
-		return filter_bits_matching(DiagnosticLog::least_frequent_bits<DiagnosticLog::Iterator_t>);
+		return _filter(Keep::least_common);
 	}
 
 	uint32_t rating() const
@@ -95,7 +92,40 @@ public:
 	}
 
 private:
-	const DiagnosticLog& _log;
+
+	enum class Keep
+	{
+		most_common,	// ties keep 1
+		least_common,	// ties keep 0
+	};
+
+	uint32_t _filter(Keep keep) const
+	{
+		if (_sorted_entries.empty()) {
+			throw Exception("Can't filter an empty diagnostic log");
+		}
+
+		auto first = _sorted_entries.begin();
+		auto last = _sorted_entries.end();
+
+		for (size_t bit = 0; bit < DiagnosticLog::entry_size && std::distance(first, last) > 1; ++bit) {
+			const auto first_one = std::partition_point(first, last, [bit](const Entry_t& entry) { return !entry[bit]; });
+
+			const auto zeros = std::distance(first, first_one);
+			const auto ones = std::distance(first_one, last);
+			const auto keep_ones = Keep::most_common == keep ? ones >= zeros : ones < zeros;
+
+			// A bit that all the survivors share doesn't filter any of them out.
+			if (keep_ones && 0 != ones)
+				first = first_one;
+			else if (0 != zeros)
+				last = first_one;
+		}
+
+		return DiagnosticLog::entry_as<uint32_t>(*first);
+	}
+
+	std::vector<Entry_t> _sorted_entries;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -108,10 +138,34 @@ struct LogProcessor
 		return DiagnosticLog::entry_as<uint32_t>(most_frequent_bits) * DiagnosticLog::flipped_entry_as<uint32_t>(most_frequent_bits);
 	}
 
+	static uint32_t power_consumption(StreamingInput& input)
+	{
+		const auto most_frequent_bits = DiagnosticLog::most_frequent_bits(input);
+		return DiagnosticLog::entry_as<uint32_t>(most_frequent_bits) * DiagnosticLog::flipped_entry_as<uint32_t>(most_frequent_bits);
+	}
+
+	static uint32_t power_consumption(const BitPlaneLog& log)
+	{
+		const auto most_frequent_bits = log.get_most_frequent_bits();
+		return DiagnosticLog::entry_as<uint32_t>(most_frequent_bits) * DiagnosticLog::flipped_entry_as<uint32_t>(most_frequent_bits);
+	}
+
+	// Logs at least this long are transposed into bit planes for the life-support rating: the
+	// sorted index costs O(n log n) to build, the planes O(n), and filtering them is O(bits * n / 64).
+	static constexpr size_t bit_plane_min_entries = 4096;
+
 	static uint32_t life_support_rating(const DiagnosticLog& log)
 	{
+		if (log.size() >= bit_plane_min_entries)
+			return BitPlaneLog{ log }.rating();
+
 		return LifeSupport(log).rating();
 	}
+
+	static uint32_t life_support_rating(const BitPlaneLog& log)
+	{
+		return log.rating();
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -129,72 +183,162 @@ public:
 	};
 
 	VentAnalyzer(std::istream& data_stream)
-		: _data_stream{ data_stream }
+		: _lines{ _load_lines(data_stream) }
 	{}
 
-	template<size_t FORMATIONS>
-	uint32_t score() const
+	VentAnalyzer(const InputBuffer& buffer)
+		: _lines{ _load_lines(buffer) }
+	{}
+
+	enum class Engine
+	{
+		raster,	// visits every point of every line
+		sweep,	// only looks at where lines start, end and cross; see OverlapSweep
+	};
+
+	// Swept lines can be far longer than rasterised ones, so their score can outgrow 32 bits.
+	template<Engine ENGINE>
+	using Score_t = std::conditional_t<Engine::sweep == ENGINE, uint64_t, uint32_t>;
+
+	template<size_t FORMATIONS, Engine ENGINE = Engine::raster>
+	Score_t<ENGINE> score() const
 	{
-		auto lines = _load_lines(_data_stream);
-		auto relevant_lines = _filter_for<FORMATIONS>(std::move(lines));
-		auto point_densities = _calculate_point_densities<FORMATIONS>(std::move(relevant_lines));
+		return score<FORMATIONS, ENGINE>(_lines);
+	}
+
+	// Scores lines that live elsewhere, e.g. in a ParsedCache, in place: lines of other formations
+	// are skipped as they're met, not filtered out into a copy. The sweep engine hands the lines to
+	// an OverlapSweep and never looks at their points. The raster engine counts points on an
+	// OverlapGrid over the lines' bounding box, unless that box is too big to hold in memory, in
+	// which case only the points that are actually covered are stored.
+	template<size_t FORMATIONS, Engine ENGINE = Engine::raster>
+	static Score_t<ENGINE> score(std::span<const Line_t> lines)
+	{
+		if constexpr (Engine::sweep == ENGINE) {
+			return _score_by_sweep<FORMATIONS>(lines);
+		}
+		else {
+			const auto bounding_box = _bounding_box<FORMATIONS>(lines);
+			if (!bounding_box)
+				return 0;
+
+			const auto [min, max] = *bounding_box;
+			if (OverlapGrid::cell_count(min, max) <= dense_grid_max_cells)
+				return _score_on_grid<FORMATIONS>(lines, min, max);
 
-		return _calculate_score(std::move(point_densities));
+			auto point_densities = _calculate_point_densities<FORMATIONS>(lines);
+
+			return _calculate_score(std::move(point_densities));
+		}
 	}
 
+	// A quarter of a byte each, so 64MB.
+	static constexpr uint64_t dense_grid_max_cells = uint64_t{ 1 } << 28;
+
 private:
 
 	static std::vector<Line_t> _load_lines(std::istream& is)
 	{
-		auto line = Line_t{};
-		auto lines = std::vector<Line_t>{};
-		while (!is.eof() && !is.fail()){
-			is >> line;
-			lines.push_back(line);
+		const auto text = std::string{ std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{} };
+
+		auto lines = scan_line2ds<Line_t::Value_t>(text);
+		if (!lines) {
+			is.setstate(std::ios::failbit);
+			throw Exception(std::format("Invalid vent line at byte offset {}: {}", lines.error().offset, conversion_error_message(lines.error().error)));
 		}
 
-		return lines;
+		return std::move(*lines);
+	}
+
+	static std::vector<Line_t> _load_lines(const InputBuffer& buffer)
+	{
+		auto lines = scan_line2ds<Line_t::Value_t>(buffer.view());
+		if (!lines) {
+			throw Exception(std::format("Invalid vent line at byte offset {}: {}", lines.error().offset, conversion_error_message(lines.error().error)));
+		}
+
+		return std::move(*lines);
 	}
 
 	template<size_t FORMATIONS>
-	static std::vector<Line_t> _filter_for(std::vector<Line_t> lines)
+	static bool _is_relevant(const Line_t& line)
 	{
-		auto should_be_removed = [](auto&& line) -> bool {
-			if constexpr (static_cast<bool>(FORMATIONS & Formation::horizontal)) {
-				if (is_horizontal(line)) {
-					return false;
-				}
+		if constexpr (static_cast<bool>(FORMATIONS & Formation::horizontal)) {
+			if (is_horizontal(line)) {
+				return true;
+			}
+		}
+
+		if constexpr (static_cast<bool>(FORMATIONS & Formation::vertical)) {
+			if (is_vertical(line)) {
+				return true;
 			}
+		}
 
-			if constexpr (static_cast<bool>(FORMATIONS & Formation::vertical)) {
-				if (is_vertical(line)) {
-					return false;
-				}
+		if constexpr (static_cast<bool>(FORMATIONS & Formation::diagonal)) {
+			if (is_diagonal(line)) {
+				return true;
 			}
+		}
 
-			if constexpr (static_cast<bool>(FORMATIONS & Formation::diagonal)) {
-				if (is_diagonal(line)) {
-					return false;
-				}
+		return false;
+	}
+
+	// Of the relevant lines; there's none if no line is relevant.
+	template<size_t FORMATIONS>
+	static std::optional<std::pair<Point_t, Point_t>> _bounding_box(std::span<const Line_t> lines)
+	{
+		auto out = std::optional<std::pair<Point_t, Point_t>>{};
+		for (const auto& line : lines) {
+			if (!_is_relevant<FORMATIONS>(line))
+				continue;
+
+			if (!out)
+				out = std::make_pair(line.start, line.start);
+
+			auto& [min, max] = *out;
+			for (const auto& point : { line.start, line.finish }) {
+				min = { std::min(min.x, point.x), std::min(min.y, point.y) };
+				max = { std::max(max.x, point.x), std::max(max.y, point.y) };
 			}
+		}
+
+		return out;
+	}
 
-			return true;
-		};
+	template<size_t FORMATIONS>
+	static uint64_t _score_by_sweep(std::span<const Line_t> lines)
+	{
+		auto sweep = OverlapSweep{};
+		for (const auto& line : lines) {
+			if (_is_relevant<FORMATIONS>(line))
+				sweep.add(line.start, line.finish);
+		}
 
-		lines.erase(std::remove_if(lines.begin(), lines.end(), should_be_removed), lines.end());
+		return sweep.overlaps();
+	}
 
-		return std::move(lines);
+	template<size_t FORMATIONS>
+	static uint32_t _score_on_grid(std::span<const Line_t> lines, const Point_t& min, const Point_t& max)
+	{
+		auto grid = OverlapGrid{ min, max };
+
+		for (const auto& line : lines) {
+			if (_is_relevant<FORMATIONS>(line))
+				rasterize<FORMATIONS>(line, [&grid](const auto&... points) { grid.add(points...); });
+		}
+
+		return grid.overlaps();
 	}
 
 	template<size_t FORMATIONS>
-	static std::map<Point_t, uint32_t> _calculate_point_densities(std::vector<Line_t> lines)
+	static std::map<Point_t, uint32_t> _calculate_point_densities(std::span<const Line_t> lines)
 	{
 		auto out = std::map<Point_t, uint32_t>{};
 
-		for (auto& line : lines) {
-			for (auto& point : rasterize<FORMATIONS>(line)) {
-				out[point]++;
-			}
+		for (const auto& line : lines) {
+			if (_is_relevant<FORMATIONS>(line))
+				rasterize<FORMATIONS>(line, [&out](const Point_t& point) { out[point]++; });
 		}
 
 		return out;
@@ -207,7 +351,7 @@ private:
 			}));
 	}
 
-	std::istream& _data_stream;
+	std::vector<Line_t> _lines;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -241,33 +385,222 @@ public:
 			});
 	}
 
+	// Same answer as the iterator version, using vector compares over the contiguous depths.
+	template<size_t WINDOW_SIZE>
+	uint32_t depth_score(std::span<const uint32_t> depths) const
+	{
+		return count_window_increases(depths, WINDOW_SIZE);
+	}
+
+	uint32_t depth_score(std::span<const uint32_t> depths, size_t window_size) const
+	{
+		return count_window_increases(depths, window_size);
+	}
+
+	// The scores for all of the window sizes, from one pass over the depths.
+	std::vector<uint32_t> depth_scores(std::span<const uint32_t> depths, std::span<const size_t> window_sizes) const
+	{
+		return count_window_increases(depths, window_sizes);
+	}
+
+	std::vector<uint32_t> depth_scores(const InputBuffer& buffer, std::span<const size_t> window_sizes) const
+	{
+		return depth_scores(std::span<const uint32_t>{ _load_depths(buffer) }, window_sizes);
+	}
+
+	// Splits the depths into overlapping chunks, one per thread of the pool.
+	template<size_t WINDOW_SIZE>
+	uint32_t depth_score(std::span<const uint32_t> depths, ThreadPool& pool) const
+	{
+		return count_window_increases(depths, WINDOW_SIZE, pool);
+	}
+
+	template<size_t WINDOW_SIZE>
+	uint32_t depth_score(const InputBuffer& buffer) const
+	{
+		return depth_score<WINDOW_SIZE>(std::span<const uint32_t>{ _load_depths(buffer) });
+	}
+
+	// Only the last WINDOW_SIZE depths are kept, so the input can be arbitrarily large.
+	template<size_t WINDOW_SIZE>
+	uint32_t depth_score(StreamingInput& input) const
+	{
+		auto scorer = SonarScorer<WINDOW_SIZE>{};
+
+		input.for_each_block('\n', [&scorer](std::string_view block, size_t offset) {
+			_for_each_depth(block, offset, [&scorer](uint32_t depth) { scorer.push(depth); });
+			});
+
+		return scorer.count();
+	}
+
 	template<typename Iter_T>
 	Direction net_direction(Iter_T begin, Iter_T end) const 
 	{
 		return std::accumulate(begin, end, Direction{});
 	}
 
+	// The accumulator type and what happens on overflow can be chosen for the reductions over
+	// parsed columns; the defaults wrap around in an int, like the iterator versions.
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	Vec2d<Value_T> net_direction(const DirectionColumns& directions) const
+	{
+		return net_direction_of<Value_T, OVERFLOW>(directions);
+	}
+
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	Vec2d<Value_T> net_direction(const InputBuffer& buffer) const
+	{
+		return net_direction_of<Value_T, OVERFLOW>(_load_directions(buffer));
+	}
+
+	// The blocks are summed in the type that reductions in Value_T use, then narrowed.
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	Vec2d<Value_T> net_direction(StreamingInput& input) const
+	{
+		using Wide_t = detail::Reduction_t<Value_T, OVERFLOW>;
+
+		auto out = Vec2d<Wide_t>{};
+		input.for_each_block('\n', [&out](std::string_view block, size_t offset) {
+			const auto block_direction = net_direction_of<Wide_t, OVERFLOW>(_parse_directions(block, offset));
+			out = { detail::add<OVERFLOW>(out.x, block_direction.x), detail::add<OVERFLOW>(out.y, block_direction.y) };
+			});
+
+		return { detail::narrow<Value_T, OVERFLOW>(out.x), detail::narrow<Value_T, OVERFLOW>(out.y) };
+	}
+
 	template<typename Iter_T>
 	Direction net_aiming(Iter_T begin, Iter_T end) const
 	{
 		return std::accumulate(begin, end, Aiming{}).to_direction();
 	}
 
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	Vec2d<Value_T> net_aiming(const DirectionColumns& directions) const
+	{
+		return net_aiming_of<Value_T, OVERFLOW>(directions);
+	}
+
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	Vec2d<Value_T> net_aiming(const InputBuffer& buffer) const
+	{
+		return net_aiming_of<Value_T, OVERFLOW>(_load_directions(buffer));
+	}
+
+	// Splits the directions into one chunk per thread of the pool and composes the chunks' aimings.
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	Vec2d<Value_T> net_aiming(const DirectionColumns& directions, ThreadPool& pool) const
+	{
+		return aiming_of<Value_T, OVERFLOW>(directions, pool).to_direction();
+	}
+
+	// Where each command leaves the boat.
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	std::vector<BasicAiming<Value_T>> aiming_trajectory(const DirectionColumns& directions, ThreadPool& pool) const
+	{
+		return aiming_trajectory_of<Value_T, OVERFLOW>(directions, pool);
+	}
+
+	// Each block is reduced as if it started from zero aim, then composed onto the running aiming,
+	// in the type that reductions in Value_T use.
+	template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+	Vec2d<Value_T> net_aiming(StreamingInput& input) const
+	{
+		using Wide_t = detail::Reduction_t<Value_T, OVERFLOW>;
+
+		auto out = BasicAiming<Wide_t>{};
+		input.for_each_block('\n', [&out](std::string_view block, size_t offset) {
+			const auto directions = _parse_directions(block, offset);
+			out = detail::compose<OVERFLOW>(out, aiming_of<Wide_t, OVERFLOW>(directions.x, directions.y));
+			});
+
+		return detail::narrow<Value_T, OVERFLOW>(out).to_direction();
+	}
+
 	uint32_t power_consumption(const DiagnosticLog& log) const
 	{
 		return LogProcessor::power_consumption(log);
 	}
 
+	uint32_t power_consumption(StreamingInput& input) const
+	{
+		return LogProcessor::power_consumption(input);
+	}
+
+	uint32_t power_consumption(const BitPlaneLog& log) const
+	{
+		return LogProcessor::power_consumption(log);
+	}
+
 	uint32_t life_support_rating(const DiagnosticLog& log) const
 	{
 		return LogProcessor::life_support_rating(log);
 	}
 
+	uint32_t life_support_rating(const BitPlaneLog& log) const
+	{
+		return LogProcessor::life_support_rating(log);
+	}
+
 	template<size_t FORMATIONS>
 	uint32_t detect_vents(std::istream& data_stream) const
 	{
 		return VentAnalyzer{ data_stream }.score<FORMATIONS>();
 	}
+
+	template<size_t FORMATIONS>
+	uint32_t detect_vents(const InputBuffer& buffer) const
+	{
+		return VentAnalyzer{ buffer }.score<FORMATIONS>();
+	}
+
+	template<size_t FORMATIONS>
+	uint32_t detect_vents(std::span<const Line2d<uint32_t>> lines) const
+	{
+		return VentAnalyzer::score<FORMATIONS>(lines);
+	}
+
+private:
+
+	template<typename Sink_T>
+	static void _for_each_depth(std::string_view text, size_t base_offset, Sink_T&& sink)
+	{
+		auto reader = LineReader{ text };
+		while (!reader.at_end()) {
+			const auto offset = reader.offset();
+			const auto line = *reader.next();
+			if (line.empty())
+				continue;
+
+			const auto depth = try_string_to<uint32_t>(line);
+			if (!depth)
+				throw Exception(std::format("Invalid depth at offset {}", base_offset + offset));
+
+			sink(*depth);
+		}
+	}
+
+	static std::vector<uint32_t> _load_depths(const InputBuffer& buffer)
+	{
+		auto depths = std::vector<uint32_t>{};
+		_for_each_depth(buffer.view(), 0, [&depths](uint32_t depth) { depths.push_back(depth); });
+
+		return depths;
+	}
+
+	static DirectionColumns _parse_directions(std::string_view text, size_t base_offset)
+	{
+		auto directions = parse_direction_columns(text);
+		if (!directions)
+			throw Exception(std::format("Invalid direction at byte offset {}", base_offset + directions.error().offset));
+
+		return std::move(*directions);
+	}
+
+	static DirectionColumns _load_directions(const InputBuffer& buffer)
+	{
+		return _parse_directions(buffer.view(), 0);
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
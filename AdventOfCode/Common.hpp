@@ -3,14 +3,20 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "StringOperations.hpp"
+#include "FormatScanner.hpp"
 
 #include <armadillo>
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <istream>
 #include <cmath>
+#include <system_error>
+#include <string_view>
+#include <expected>
+#include <concepts>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -26,6 +32,26 @@ struct Exception : public std::runtime_error
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// A 128-bit integer, where the compiler has one (GCC and Clang do, MSVC doesn't).
+#if defined(__SIZEOF_INT128__)
+#define AOC_HAVE_INT128 1
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline std::string_view conversion_error_message(std::errc error)
+{
+	switch (error)
+	{
+	case std::errc::result_out_of_range: return "Value out-of-range";
+	default: return "Non-numeric character";
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 template<typename Value_T>
 struct Vec2d
 {
@@ -120,6 +146,34 @@ struct Line2d
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Parses "x,y"
+template<typename Value_T>
+std::expected<Vec2d<Value_T>, std::errc> parse_vec2d(std::string_view str)
+{
+	const auto parsed = FormatScanner<"{},{}", Value_T>::scan(str);
+	if (!parsed)
+		return std::unexpected(parsed.error().error);
+
+	const auto [x, y] = *parsed;
+	return Vec2d<Value_T>{ x, y };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Parses "x,y -> x,y"
+template<typename Value_T>
+std::expected<Line2d<Value_T>, std::errc> parse_line2d(std::string_view str)
+{
+	const auto parsed = FormatScanner<"{},{} -> {},{}", Value_T>::scan(str);
+	if (!parsed)
+		return std::unexpected(parsed.error().error);
+
+	const auto [x0, y0, x1, y1] = *parsed;
+	return Line2d<Value_T>{ Vec2d<Value_T>{ x0, y0 }, Vec2d<Value_T>{ x1, y1 } };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 template<typename Value_T>
 bool is_vertical(const Line2d<Value_T>& line)
 {
@@ -139,43 +193,49 @@ bool is_horizontal(const Line2d<Value_T>& line)
 template<typename Value_T>
 bool is_diagonal(const Line2d<Value_T>& line)
 {
-	return std::abs(static_cast<int>(line.finish.x) - static_cast<int>(line.start.x)) == std::abs(static_cast<int>(line.finish.y) - static_cast<int>(line.start.y));
+	// Larger minus smaller, which can't overflow however far apart the ends are.
+	auto distance = [](Value_T from, Value_T to) { return std::max(from, to) - std::min(from, to); };
+
+	return distance(line.start.x, line.finish.x) == distance(line.start.y, line.finish.y);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template<size_t ORIENTATION, typename Value_T>
-std::vector<Vec2d<Value_T>> rasterize(const Line2d<Value_T>& line)
+// Calls visit(point) for every point of the line, without allocating. A visitor that can also be
+// called as visit(first, last) gets each horizontal line as that one run of a row instead.
+template<size_t ORIENTATION, typename Value_T, typename Visitor_T>
+void rasterize(const Line2d<Value_T>& line, Visitor_T&& visit)
 {
-	auto out = std::vector<Vec2d<Value_T>>{};
-	
-	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::horizontal)) {
-		if (is_vertical(line)) {
-			const auto y_min = std::min(line.start.y, line.finish.y);
-			const auto y_max = std::max(line.start.y, line.finish.y);
+	using Point_t = Vec2d<Value_T>;
 
-			auto out = std::vector<Vec2d<Value_T>>{ y_max - y_min + 1 };
+	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::horizontal)) {
+		if (is_horizontal(line)) {
+			const auto x_min = std::min(line.start.x, line.finish.x);
+			const auto x_max = std::max(line.start.x, line.finish.x);
 
-			for (auto y = y_min; y <= y_max; ++y) {
-				out[y - y_min] = Vec2d<Value_T>{ line.start.x, y };
+			if constexpr (std::invocable<Visitor_T&, const Point_t&, const Point_t&>) {
+				visit(Point_t{ x_min, line.start.y }, Point_t{ x_max, line.start.y });
+			}
+			else {
+				for (auto x = x_min; x <= x_max; ++x) {
+					visit(Point_t{ x, line.start.y });
+				}
 			}
 
-			return out;
+			return;
 		}
 	}
 
 	if constexpr (static_cast<bool>(ORIENTATION & Line2d<Value_T>::vertical)) {
-		if (is_horizontal(line)) {
-			const auto x_min = std::min(line.start.x, line.finish.x);
-			const auto x_max = std::max(line.start.x, line.finish.x);
-
-			auto out = std::vector<Vec2d<Value_T>>{x_max - x_min + 1};
+		if (is_vertical(line)) {
+			const auto y_min = std::min(line.start.y, line.finish.y);
+			const auto y_max = std::max(line.start.y, line.finish.y);
 
-			for (auto x = x_min; x <= x_max; ++x) {
-				out[x - x_min] = Vec2d<Value_T>{ x, line.start.y };
+			for (auto y = y_min; y <= y_max; ++y) {
+				visit(Point_t{ line.start.x, y });
 			}
 
-			return out;
+			return;
 		}
 	}
 
@@ -184,18 +244,24 @@ std::vector<Vec2d<Value_T>> rasterize(const Line2d<Value_T>& line)
 			const auto [lower, upper] = line.start.x < line.finish.x ? std::make_pair(line.start, line.finish) : std::make_pair(line.finish, line.start);
 			const auto y_increment = lower.y < upper.y ? 1 : -1;
 
-			auto out = std::vector<Vec2d<Value_T>>{ upper.x - lower.x + 1 };
-
-			for (auto point = lower; point.x <= upper.x; ++point.x, point.y += y_increment)
-			{
-				out[point.x - lower.x] = point;
+			for (auto point = lower; point.x <= upper.x; ++point.x, point.y += y_increment) {
+				visit(point);
 			}
 
-			return out;
+			return;
 		}
 	}
 
-	throw Exception("Only horizontal or vertical lines can be rasterized");
+	throw Exception("Only horizontal, vertical or diagonal lines can be rasterized");
+}
+
+template<size_t ORIENTATION, typename Value_T>
+std::vector<Vec2d<Value_T>> rasterize(const Line2d<Value_T>& line)
+{
+	auto out = std::vector<Vec2d<Value_T>>{};
+	rasterize<ORIENTATION>(line, [&out](const Vec2d<Value_T>& point) { out.push_back(point); });
+
+	return out;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -210,7 +276,7 @@ namespace std
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename Value_T>
-istream& operator>>(std::istream& is, aoc::Vec2d<Value_T>& vec) try
+istream& operator>>(std::istream& is, aoc::Vec2d<Value_T>& vec)
 {
 	if (is.eof())
 		return is;
@@ -218,32 +284,21 @@ istream& operator>>(std::istream& is, aoc::Vec2d<Value_T>& vec) try
 	auto str = std::string{};
 	is >> str;
 
-	auto x_and_y_str = split(str, ',');
-	if (x_and_y_str.size() != 2) {
+	const auto parsed = aoc::parse_vec2d<Value_T>(str);
+	if (!parsed) {
 		is.setstate(std::ios::failbit);
 		throw aoc::Exception("Failed to read Vec2d");
 	}
 
-	vec.x = string_to<Value_T>(x_and_y_str[0]);
-	vec.y = string_to<Value_T>(x_and_y_str[1]);
+	vec = *parsed;
 
 	return is;
 }
-catch (std::invalid_argument&)
-{
-	is.setstate(std::ios::failbit);
-	throw aoc::Exception("Failed to extract Line2d from stream");
-}
-catch (std::out_of_range&)
-{
-	is.setstate(std::ios::failbit);
-	throw aoc::Exception("Failed to extract Line2d from stream");
-}
 
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename Value_T>
-istream& operator>>(istream& is, aoc::Line2d<Value_T>& line) try
+istream& operator>>(istream& is, aoc::Line2d<Value_T>& line)
 {
 	line = aoc::Line2d<Value_T>{{0, 0}, {0, 0}};
 
@@ -264,16 +319,6 @@ istream& operator>>(istream& is, aoc::Line2d<Value_T>& line) try
 
 	return is;
 }
-catch (std::invalid_argument&)
-{
-	is.setstate(std::ios::failbit);
-	throw aoc::Exception("Failed to extract Line2d from stream");
-}
-catch (std::out_of_range&)
-{
-	is.setstate(std::ios::failbit);
-	throw aoc::Exception("Failed to extract Line2d from stream");
-}
 
 ///////////////////////////////////////////////////////////////////////////////
 
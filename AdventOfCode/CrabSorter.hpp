@@ -4,11 +4,15 @@
 
 #include "Common.hpp"
 #include "StringOperations.hpp"
+#include "NumberParsing.hpp"
+#include "InputBuffer.hpp"
 
 #include <cstdint>
 #include <vector>
+#include <span>
 #include <istream>
 #include <numeric>
+#include <format>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -17,35 +21,41 @@ namespace aoc
 class CrabSorter
 {
 public:
-	CrabSorter load(std::istream& stream) try
+	CrabSorter load(std::istream& stream, ParseStrategy strategy = ParseStrategy::tokenized)
 	{
 		auto str = std::string{};
 		std::getline(stream, str);
 
-		const auto position_strings = split(str, ',');
+		const auto error = ParseStrategy::vectorized == strategy ? _load_vectorized(str) : _load_tokenized(str);
+		if (std::errc{} != error) {
+			_positions.clear();
 
-		_positions.resize(position_strings.size());
-
-		std::transform(position_strings.begin(), position_strings.end(), _positions.begin(), [](const auto& s) {
-			return string_to<uint32_t>(s);
-			});
+			stream.setstate(std::ios::failbit);
+			throw Exception(std::format("Failed to read crab positions from stream: {}", conversion_error_message(error)));
+		}
 
 		return *this;
 	}
-	catch (const std::invalid_argument&)
-	{
-		stream.setstate(std::ios::failbit);
-		throw Exception("Failed to read Lanternfish shoal from stream: Non-numeric character");
-	}
-	catch (const std::out_of_range&)
+
+	CrabSorter load(const InputBuffer& buffer, ParseStrategy strategy = ParseStrategy::tokenized)
 	{
-		stream.setstate(std::ios::failbit);
-		throw Exception("Failed to read Lanternfish shoal from stream: Value out-of-range");
+		const auto str = LineReader{ buffer }.next().value_or(std::string_view{});
+
+		const auto error = ParseStrategy::vectorized == strategy ? _load_vectorized(str) : _load_tokenized(str);
+		if (std::errc{} != error) {
+			_positions.clear();
+
+			throw Exception(std::format("Failed to read crab positions: {}", conversion_error_message(error)));
+		}
+
+		return *this;
 	}
-	catch (const Exception&)
+
+	CrabSorter load(std::span<const uint32_t> positions)
 	{
-		stream.setstate(std::ios::failbit);
-		throw Exception("Failed to read Lanternfish shoal from stream: Value out-of-range");
+		_positions.assign(positions.begin(), positions.end());
+
+		return *this;
 	}
 
 	auto positions() const { return _positions; }
@@ -70,6 +80,33 @@ public:
 
 private:
 
+	std::errc _load_tokenized(std::string_view str)
+	{
+		_positions.clear();
+		_positions.reserve(std::count(str.begin(), str.end(), ',') + 1);
+
+		for (const auto position_str : split_view(str, ',')) {
+			const auto position = try_string_to<uint32_t>(position_str);
+			if (!position)
+				return position.error();
+
+			_positions.push_back(*position);
+		}
+
+		return {};
+	}
+
+	std::errc _load_vectorized(std::string_view str)
+	{
+		auto positions = parse_csv_uint32s(str);
+		if (!positions)
+			return positions.error();
+
+		_positions = std::move(*positions);
+
+		return {};
+	}
+
 	template<typename FuelBurnFn_T>
 	uint32_t _position_cost(size_t position, FuelBurnFn_T fuel_burn_fn) const
 	{
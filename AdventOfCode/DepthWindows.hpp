@@ -0,0 +1,211 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Simd.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// With FIXED_WINDOW > 0, the window is a compile-time constant and window_size is ignored.
+template<size_t FIXED_WINDOW>
+uint32_t count_window_increases(std::span<const uint32_t> depths, size_t window_size)
+{
+	if constexpr (FIXED_WINDOW > 0)
+		window_size = FIXED_WINDOW;
+
+	if (depths.size() <= window_size)
+		return 0;
+
+	const auto compare_count = depths.size() - window_size;
+	const auto older = depths.data();
+	const auto newer = depths.data() + window_size;
+
+	auto i = size_t{ 0 };
+	auto out = uint32_t{ 0 };
+
+#if defined(AOC_HAVE_AVX2)
+	// There's no unsigned compare, so flip the sign bits and compare signed.
+	const auto sign_bits_8 = _mm256_set1_epi32(static_cast<int>(0x80000000));
+	auto counts_8 = _mm256_setzero_si256();
+	for (; i + 8 <= compare_count; i += 8) {
+		const auto a = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(older + i)), sign_bits_8);
+		const auto b = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(newer + i)), sign_bits_8);
+		counts_8 = _mm256_sub_epi32(counts_8, _mm256_cmpgt_epi32(b, a));
+	}
+
+	alignas(32) auto lanes_8 = std::array<uint32_t, 8>{};
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes_8.data()), counts_8);
+	out = std::accumulate(lanes_8.begin(), lanes_8.end(), out);
+#elif defined(AOC_HAVE_SSE2)
+	const auto sign_bits_4 = _mm_set1_epi32(static_cast<int>(0x80000000));
+	auto counts_4 = _mm_setzero_si128();
+	for (; i + 4 <= compare_count; i += 4) {
+		const auto a = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(older + i)), sign_bits_4);
+		const auto b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(newer + i)), sign_bits_4);
+		counts_4 = _mm_sub_epi32(counts_4, _mm_cmpgt_epi32(b, a));
+	}
+
+	alignas(16) auto lanes_4 = std::array<uint32_t, 4>{};
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes_4.data()), counts_4);
+	out = std::accumulate(lanes_4.begin(), lanes_4.end(), out);
+#endif
+
+	for (; i < compare_count; ++i) {
+		out += newer[i] > older[i] ? 1 : 0;
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The number of sliding windows of window_size depths whose sum is larger than that of the window
+// before. Neighbouring windows share all but one depth, so that's the number of i for which
+// depths[i + window_size] > depths[i]. The compares are done eight (AVX2) or four (SSE2) at a
+// time, and the matches counted per lane by subtracting the all-ones compare masks.
+// Windows of 1, 2, 3, 4 and 8 get kernels with the offset built in.
+inline uint32_t count_window_increases(std::span<const uint32_t> depths, size_t window_size)
+{
+	switch (window_size)
+	{
+	case 1: return detail::count_window_increases<1>(depths, window_size);
+	case 2: return detail::count_window_increases<2>(depths, window_size);
+	case 3: return detail::count_window_increases<3>(depths, window_size);
+	case 4: return detail::count_window_increases<4>(depths, window_size);
+	case 8: return detail::count_window_increases<8>(depths, window_size);
+	default: return detail::count_window_increases<0>(depths, window_size);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Increase counts for several window sizes in a single pass over the depths. They're walked a
+// cache-sized block at a time, and each window's compares for a block are made while it's still
+// in cache, so memory is only streamed through once however many windows there are.
+inline std::vector<uint32_t> count_window_increases(std::span<const uint32_t> depths, std::span<const size_t> window_sizes)
+{
+	constexpr size_t block_size = 4096;
+
+	auto out = std::vector<uint32_t>(window_sizes.size());
+
+	for (size_t first = 0; first < depths.size(); first += block_size) {
+		for (size_t w = 0; w < window_sizes.size(); ++w) {
+			const auto window_size = window_sizes[w];
+			if (depths.size() <= window_size || first >= depths.size() - window_size)
+				continue;
+
+			const auto compare_count = std::min(block_size, depths.size() - window_size - first);
+			out[w] += count_window_increases(depths.subspan(first, compare_count + window_size), window_size);
+		}
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Scores depths as they arrive, keeping only the last WINDOW_SIZE of them: each new depth is
+// compared with the one WINDOW_SIZE before it, which is then overwritten in the ring. push() is
+// for one thread at a time, but count() can be read from any thread while it's running.
+template<size_t WINDOW_SIZE>
+	requires (WINDOW_SIZE > 0)
+class SonarScorer
+{
+public:
+	void push(uint32_t depth)
+	{
+		auto& oldest = _window[_next];
+		if (_filled && depth > oldest)
+			_count.store(_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+		oldest = depth;
+		if (++_next == WINDOW_SIZE) {
+			_next = 0;
+			_filled = true;
+		}
+	}
+
+	// Depths inside the batch are compared with each other by count_window_increases; only the
+	// first WINDOW_SIZE of them need the ring.
+	void push(std::span<const uint32_t> depths)
+	{
+		const auto head = std::min(depths.size(), WINDOW_SIZE);
+		for (size_t i = 0; i < head; ++i) {
+			push(depths[i]);
+		}
+
+		if (depths.size() <= WINDOW_SIZE)
+			return;
+
+		_count.store(_count.load(std::memory_order_relaxed) + count_window_increases(depths, WINDOW_SIZE), std::memory_order_relaxed);
+
+		// The ring is full after the head, so it just takes the last WINDOW_SIZE depths, oldest at _next.
+		const auto tail = depths.last(WINDOW_SIZE);
+		for (size_t i = 0; i < WINDOW_SIZE; ++i) {
+			_window[(_next + i) % WINDOW_SIZE] = tail[i];
+		}
+	}
+
+	uint32_t count() const { return _count.load(std::memory_order_relaxed); }
+
+private:
+	std::array<uint32_t, WINDOW_SIZE> _window{};
+	size_t _next{ 0 };
+	bool _filled{ false };
+	std::atomic<uint32_t> _count{ 0 };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Sweeps shorter than this, per thread, are counted on the calling thread alone.
+inline constexpr size_t parallel_min_depth_compares = size_t{ 1 } << 18;
+
+// The same count, with the compares split into one contiguous chunk per thread of the pool. Each
+// chunk reads window_size depths past its last compare, so the chunks overlap by that much and
+// every compare is made exactly once.
+inline uint32_t count_window_increases(std::span<const uint32_t> depths, size_t window_size, ThreadPool& pool)
+{
+	if (depths.size() <= window_size)
+		return 0;
+
+	auto chunk_counts = std::vector<CacheAligned<uint32_t>>(pool.thread_count());
+
+	const auto chunk_count = parallel_chunks(pool, depths.size() - window_size, parallel_min_depth_compares,
+		[depths, window_size, &chunk_counts](size_t chunk, size_t first, size_t last) {
+			chunk_counts[chunk].value = count_window_increases(depths.subspan(first, last - first + window_size), window_size);
+		});
+
+	return std::accumulate(chunk_counts.begin(), chunk_counts.begin() + chunk_count, uint32_t{ 0 }, [](uint32_t total, const auto& count) {
+		return total + count.value;
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -3,14 +3,28 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Common.hpp"
-
+#include "InputBuffer.hpp"
+#include "BitLineDecoder.hpp"
+#include "FormatScanner.hpp"
+#include "PackedBits.hpp"
+#include "PositionalPopcount.hpp"
+#include "Parallel.hpp"
+#include "StreamingInput.hpp"
+
+#include <cstddef>
 #include <cstdint>
+#include <expected>
 #include <vector>
 #include <array>
 #include <istream>
+#include <span>
+#include <iterator>
+#include <memory>
+#include <string>
 #include <numeric>
 #include <algorithm>
 #include <format>
+#include <functional>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -19,137 +33,335 @@ namespace aoc
 
 ///////////////////////////////////////////////////////////////////////////////
 
-class DiagnosticLog
+// The entries of a diagnostic log, bit-packed: a 12-bit entry takes two bytes. The log only grows
+// by appending, and keeps running per-bit counts, so the bit frequencies are O(width) queries.
+template<size_t ENTRY_WIDTH>
+	requires (ENTRY_WIDTH > 0)
+class BasicDiagnosticLog
 {
 public:
-	static constexpr uint32_t entry_size = 12;
-	using Entry_t = std::array<bool, entry_size>;
+	static constexpr uint32_t entry_size = static_cast<uint32_t>(ENTRY_WIDTH);
+	using Entry_t = PackedBits<ENTRY_WIDTH>;
 
 private:
 	std::vector<Entry_t> entries;
 
 public:
 
-	using Iterator_t = decltype(entries.begin());
+	// Entries can't be modified in place, as that would invalidate the running counts.
 	using ConstIterator_t = decltype(entries.cbegin());
+	using Iterator_t = ConstIterator_t;
 	using Size_t = decltype(entries.size());
 
-	DiagnosticLog(std::istream& is)
+	BasicDiagnosticLog(std::istream& is)
 	{
 		load(is);
 	}
 
-	DiagnosticLog() {}
+	BasicDiagnosticLog(const InputBuffer& buffer)
+	{
+		load(buffer);
+	}
 
+	BasicDiagnosticLog() {}
 
-	void load(std::istream& is) try
+
+	void load(std::istream& is)
 	{
-		entries.clear();
+		const auto text = std::string{ std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{} };
+
+		try {
+			clear();
+			append(std::string_view{ text });
+		}
+		catch (const Exception&) {
+			is.setstate(std::ios::failbit);
+			throw;
+		}
+	}
 
-		using Iter_t = std::istream_iterator<Entry_t>;
-		std::copy(Iter_t(is), Iter_t(), std::back_inserter(entries));
+	void load(const InputBuffer& buffer)
+	{
+		clear();
+		append(buffer.view());
+	}
+
+	// Entries packed as by BitLineDecoder, first bit most significant, e.g. a ParsedCache section.
+	// The log owns its entries, so they're copied in and counted, though not parsed again.
+	void load(std::span<const uint64_t> packed_entries)
+		requires (ENTRY_WIDTH <= 64)
+	{
+		clear();
+		append(packed_entries);
 	}
-	catch (const Exception&)
+
+	void clear()
 	{
 		entries.clear();
+		_counts = BitCounts{};
+	}
 
-		throw;
+	// O(width)
+	void append(const Entry_t& entry)
+	{
+		entries.push_back(entry);
+		_counts.add(std::span<const Entry_t>{ &entry, 1 });
 	}
 
-	ConstIterator_t begin() const { return entries.begin(); }
-	Iterator_t begin() { return entries.begin(); }
+	// Batches are counted with the positional popcount.
+	void append(std::span<const Entry_t> new_entries)
+	{
+		entries.insert(entries.end(), new_entries.begin(), new_entries.end());
+		_counts.add(new_entries);
+	}
+
+	void append(std::span<const Entry_t> new_entries, ThreadPool& pool)
+	{
+		entries.insert(entries.end(), new_entries.begin(), new_entries.end());
+		_counts.add(_count(new_entries, pool));
+	}
 
+	void append(std::span<const uint64_t> packed_entries)
+		requires (ENTRY_WIDTH <= 64)
+	{
+		const auto first_new = entries.size();
+		entries.reserve(first_new + packed_entries.size());
+
+		for (const auto packed_entry : packed_entries) {
+			entries.push_back(Entry_t::from_word(packed_entry));
+		}
+
+		_counts.add(std::span<const Entry_t>{ entries }.subspan(first_new));
+	}
+
+	// Appends the entries on the lines of text. If any line is invalid, nothing is appended.
+	void append(std::string_view text)
+	{
+		const auto first_new = entries.size();
+		entries.reserve(first_new + text.size() / (entry_size + 1));
+
+		const auto result = _for_each_entry(text, [this](const Entry_t& entry) {
+			entries.push_back(entry);
+			});
+
+		if (!result) {
+			entries.resize(first_new);
+			throw Exception(std::format("Invalid log line at byte offset {}", result.error().offset));
+		}
+
+		_counts.add(std::span<const Entry_t>{ entries }.subspan(first_new));
+	}
+
+	static Entry_t parse_entry(std::string_view str)
+	{
+		if constexpr (ENTRY_WIDTH <= 64) {
+			const auto packed_entry = FormatScanner<_entry_format>::scan(str);
+			if (!packed_entry) {
+				throw Exception(std::format("Invalid log line: {}", str));
+			}
+
+			return Entry_t::from_word(std::get<0>(*packed_entry));
+		}
+		else {
+			if (str.length() != entry_size) {
+				throw Exception(std::format("Invalid log line: {}", str));
+			}
+
+			auto entry = Entry_t{};
+			for (size_t i = 0; i < entry_size; ++i) {
+				if ('0' != str[i] && '1' != str[i]) {
+					throw Exception(std::format("Invalid character in log line: {}", str[i]));
+				}
+
+				entry.set(entry_size - 1 - i, '1' == str[i]);
+			}
+
+			return entry;
+		}
+	}
+
+	ConstIterator_t begin() const { return entries.begin(); }
 	ConstIterator_t end() const { return entries.end(); }
-	Iterator_t end() { return entries.end(); }
 
 	Size_t size() const { return entries.size(); }
 
 	Entry_t get_most_frequent_bits() const
 	{
-		return most_frequent_bits(begin(), end());
+		return _counts.most_common_bits();
 	}
 
 	template<typename LogEntryIter_T>
 	static Entry_t most_frequent_bits(LogEntryIter_T begin, LogEntryIter_T end)
 	{
-		auto bit_counts = bit_balance(begin, end);
-		return create_most_common_bits(std::move(bit_counts));
+		auto counts = BitCounts{};
+		if constexpr (std::contiguous_iterator<LogEntryIter_T>) {
+			counts.add(std::span<const Entry_t>{ std::to_address(begin), static_cast<size_t>(end - begin) });
+		}
+		else {
+			std::for_each(begin, end, [&counts](const Entry_t& entry) { counts.add(std::span<const Entry_t>{ &entry, 1 }); });
+		}
+
+		return counts.most_common_bits();
+	}
+
+	// Most frequent bits of a log that is streamed through rather than loaded.
+	static Entry_t most_frequent_bits(StreamingInput& input)
+	{
+		auto counts = BitCounts{};
+		auto block_entries = std::vector<Entry_t>{};
+
+		input.for_each_block('\n', [&counts, &block_entries](std::string_view block, size_t offset) {
+			block_entries.clear();
+
+			const auto result = _for_each_entry(block, [&block_entries](const Entry_t& entry) { block_entries.push_back(entry); });
+			if (!result)
+				throw Exception(std::format("Invalid log line at byte offset {}", offset + result.error().offset));
+
+			counts.add(block_entries);
+			});
+
+		return counts.most_common_bits();
 	}
 
 	Entry_t get_least_frequent_bits() const
 	{
-		return least_frequent_bits(begin(), end());
+		return get_most_frequent_bits().flipped();
+	}
+
+	// Logs shorter than this, per thread, are counted on the calling thread alone.
+	static constexpr size_t parallel_min_entries = size_t{ 1 } << 16;
+
+	// Recounts all the entries on the pool, rather than using the running counts.
+	Entry_t get_most_frequent_bits(ThreadPool& pool) const
+	{
+		return _count(entries, pool).most_common_bits();
+	}
+
+	Entry_t get_least_frequent_bits(ThreadPool& pool) const
+	{
+		return get_most_frequent_bits(pool).flipped();
 	}
 
 	template<typename LogEntryIter_T>
 	static Entry_t least_frequent_bits(LogEntryIter_T begin, LogEntryIter_T end)
 	{
-		auto bit_counts = bit_balance(begin, end);
-		return create_least_common_bits(std::move(bit_counts));
+		return most_frequent_bits(begin, end).flipped();
 	}
 
 	template<typename Out_T>
 	static Out_T entry_as(const Entry_t& entry)
 	{
-		return std::accumulate(entry.begin(), entry.end(), Out_T{ 0 }, [](auto curr, auto next) {
-			curr <<= 1;
-			if (next)
-				curr |= 1;
-
-			return curr;
-			});
+		return entry.template as<Out_T>();
 	}
 
 	template<typename Out_T>
 	static Out_T flipped_entry_as(const Entry_t& entry)
 	{
-		return std::accumulate(entry.begin(), entry.end(), Out_T{ 0 }, [](auto curr, auto next) {
-			curr <<= 1;
-			if (!next)
-				curr |= 1;
-
-			return curr;
-			});
+		return entry.flipped().template as<Out_T>();
 	}
 
 private:
-	template<typename LogEntryIter_T>
-	static std::array<int, aoc::DiagnosticLog::entry_size> bit_balance(LogEntryIter_T begin, LogEntryIter_T end)
-	{
-		return std::accumulate(begin, end, std::array<int, aoc::DiagnosticLog::entry_size>{},
-			[](auto&& curr, auto&& entry) {
-				std::transform(curr.begin(), curr.end(), entry.begin(), curr.begin(),
-					[](auto count, auto bit) {
-						return count + (bit ? 1 : -1);
-					});
 
-				return curr;
-			});
-	}
+	// "{bits:NN}"
+	static constexpr auto _entry_format = []() {
+		char format[] = "{bits:00}";
+		format[6] = static_cast<char>('0' + ENTRY_WIDTH / 10 % 10);
+		format[7] = static_cast<char>('0' + ENTRY_WIDTH % 10);
+
+		return FormatString{ format };
+	}();
 
-	static Entry_t create_most_common_bits(std::array<int, aoc::DiagnosticLog::entry_size>&& counts)
+	// The number of entries, and how many of them have each bit set.
+	class BitCounts
 	{
-		auto out = Entry_t{};
-		std::transform(counts.begin(), counts.end(), out.begin(), [](auto count) {
-			return count >= 0 ? true : false;
-			});
+	public:
+		void add(std::span<const Entry_t> entries)
+		{
+			static_assert(sizeof(Entry_t) == Entry_t::word_count * sizeof(typename Entry_t::Word_t));
+
+			const auto words = std::span<const typename Entry_t::Word_t>{
+				reinterpret_cast<const typename Entry_t::Word_t*>(entries.data()), entries.size() * Entry_t::word_count };
+
+			positional_popcount(words, Entry_t::word_count, _ones);
+			_total += entries.size();
+		}
+
+		void add(const BitCounts& other)
+		{
+			std::transform(_ones.begin(), _ones.end(), other._ones.begin(), _ones.begin(), std::plus<>{});
+			_total += other._total;
+		}
+
+		// Ties go to 1.
+		Entry_t most_common_bits() const
+		{
+			auto out = Entry_t{};
+			for (size_t position = 0; position < ENTRY_WIDTH; ++position) {
+				out.set(position, 2 * _ones[position] >= _total);
+			}
+
+			return out;
+		}
+
+	private:
+		std::array<uint64_t, Entry_t::word_count * Entry_t::word_bits> _ones{};
+		uint64_t _total{ 0 };
+	};
+
+	template<typename Sink_T>
+	static std::expected<void, ParseError> _for_each_entry(std::string_view text, Sink_T&& sink)
+	{
+		if constexpr (ENTRY_WIDTH <= 64) {
+			return BitLineDecoder{ ENTRY_WIDTH }.for_each(text, [&sink](uint64_t packed_entry) {
+				sink(Entry_t::from_word(packed_entry));
+				});
+		}
+		else {
+			auto reader = LineReader{ text };
+			while (!reader.at_end()) {
+				const auto offset = reader.offset();
+				const auto line = *reader.next();
+				if (line.empty())
+					continue;
+
+				try {
+					sink(parse_entry(line));
+				}
+				catch (const Exception&) {
+					return std::unexpected(ParseError{ offset, std::errc::invalid_argument });
+				}
+			}
 
-		return out;
+			return {};
+		}
 	}
 
-	static Entry_t create_least_common_bits(std::array<int, aoc::DiagnosticLog::entry_size>&& counts)
+	// Counts the bits of a chunk of the entries per thread of the pool, then adds up the counts.
+	static BitCounts _count(std::span<const Entry_t> entries_to_count, ThreadPool& pool)
 	{
-		auto out = Entry_t{};
-		std::transform(counts.begin(), counts.end(), out.begin(), [](auto count) {
-			return count >= 0 ? false : true;
+		auto partial_counts = std::vector<CacheAligned<BitCounts>>(pool.thread_count());
+
+		const auto chunk_count = parallel_chunks(pool, entries_to_count.size(), parallel_min_entries, [entries_to_count, &partial_counts](size_t chunk, size_t first, size_t last) {
+			partial_counts[chunk].value.add(entries_to_count.subspan(first, last - first));
 			});
 
+		auto out = BitCounts{};
+		for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+			out.add(partial_counts[chunk].value);
+		}
+
 		return out;
 	}
+
+	BitCounts _counts;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
+using DiagnosticLog = BasicDiagnosticLog<12>;
+
+///////////////////////////////////////////////////////////////////////////////
+
 }	// namespace: aoc
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -159,9 +371,10 @@ namespace std
 
 ///////////////////////////////////////////////////////////////////////////////
 
-istream & operator>>(istream & is, aoc::DiagnosticLog::Entry_t & entry)
+template<size_t WIDTH>
+istream & operator>>(istream & is, aoc::PackedBits<WIDTH> & entry)
 {
-	entry = aoc::DiagnosticLog::Entry_t{};
+	entry = aoc::PackedBits<WIDTH>{};
 
 	auto param_str = std::string{};
 	is >> param_str;
@@ -172,22 +385,8 @@ istream & operator>>(istream & is, aoc::DiagnosticLog::Entry_t & entry)
 		return is;
 	}
 
-	if (param_str.length() != aoc::DiagnosticLog::entry_size) {
-		is.setstate(std::ios::failbit);
-		throw aoc::Exception(std::format("Invalid log line: {}", param_str));
-	}
-
 	try {
-		std::transform(param_str.begin(), param_str.end(), entry.begin(),
-			[](auto c) {
-				switch (c)
-				{
-				case '0': return false;
-				case '1': return true;
-				default:
-					throw aoc::Exception(std::format("Invalid character in log line: {}", c));
-				}
-			});
+		entry = aoc::BasicDiagnosticLog<WIDTH>::parse_entry(param_str);
 	}
 	catch (const aoc::Exception&)
 	{
@@ -0,0 +1,658 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+#include "Simd.hpp"
+#include "Parallel.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+using Direction = Vec2d<int>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+// What the course reductions do with a value that doesn't fit their accumulator: wrap around
+// modulo 2^N, as the vector lanes do, or throw an aoc::Exception.
+enum class Overflow
+{
+	wrap,
+	check,
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Signed overflow is undefined, so wrapping arithmetic is done on the unsigned type of the same
+// width, and converted back.
+template<typename Value_T>
+struct wrapping_type
+{
+	using type = std::make_unsigned_t<Value_T>;
+};
+
+#if defined(AOC_HAVE_INT128)
+template<>
+struct wrapping_type<int128_t>
+{
+	using type = uint128_t;
+};
+#endif
+
+template<typename Value_T>
+Value_T wrapping_add(Value_T a, Value_T b)
+{
+	using Unsigned_t = typename wrapping_type<Value_T>::type;
+	return static_cast<Value_T>(static_cast<Unsigned_t>(static_cast<Unsigned_t>(a) + static_cast<Unsigned_t>(b)));
+}
+
+template<typename Value_T>
+Value_T wrapping_multiply(Value_T a, Value_T b)
+{
+	using Unsigned_t = typename wrapping_type<Value_T>::type;
+	return static_cast<Value_T>(static_cast<Unsigned_t>(static_cast<Unsigned_t>(a) * static_cast<Unsigned_t>(b)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename Value_T>
+struct BasicAiming
+{
+	using Value_t = Value_T;
+	using This_t = BasicAiming<Value_t>;
+
+	Value_t x{};
+	Value_t aim{};
+	Value_t depth{};
+
+	Vec2d<Value_t> to_direction() const
+	{
+		return { x, depth };
+	}
+
+	This_t operator+(const Direction& d) const
+	{
+		const auto new_aim = detail::wrapping_add(this->aim, static_cast<Value_t>(d.y));
+		return {
+			detail::wrapping_add(this->x, static_cast<Value_t>(d.x)),
+			new_aim,
+			detail::wrapping_add(this->depth, detail::wrapping_multiply(static_cast<Value_t>(d.x), new_aim))
+		};
+	}
+
+	// Applying a run of commands is an affine map of the state, summarised by the Aiming it reaches
+	// from zero. Composing two of them: x and aim add up, and every forward move of the second run
+	// also goes down by this aim. The composition is associative, so runs can be reduced in any
+	// grouping as long as their order is kept. Like operator+, this wraps around on overflow.
+	This_t then(const This_t& next) const
+	{
+		return {
+			detail::wrapping_add(this->x, next.x),
+			detail::wrapping_add(this->aim, next.aim),
+			detail::wrapping_add(this->depth, detail::wrapping_add(next.depth, detail::wrapping_multiply(this->aim, next.x)))
+		};
+	}
+
+	template<typename Out_T>
+	BasicAiming<Out_T> as() const
+	{
+		return { static_cast<Out_T>(x), static_cast<Out_T>(aim), static_cast<Out_T>(depth) };
+	}
+
+	bool operator==(const This_t&) const = default;
+};
+
+using Aiming = BasicAiming<int>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A list of Directions stored as structure-of-arrays, so that the reductions over it vectorize.
+struct DirectionColumns
+{
+	std::vector<int> x;
+	std::vector<int> y;
+
+	size_t size() const { return x.size(); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Parses "forward|up|down <n>" commands, one per line, in two passes. The first classifies each
+// command from its first byte and collects the magnitudes; the second turns those into the x and
+// y deltas without branching.
+inline std::expected<DirectionColumns, ParseError> parse_direction_columns(std::string_view text)
+{
+	enum Command : uint8_t
+	{
+		forward,
+		up,
+		down,
+	};
+
+	constexpr auto keywords = std::array<std::string_view, 3>{ "forward ", "up ", "down " };
+	constexpr auto x_signs = std::array<int, 3>{ 1, 0, 0 };
+	constexpr auto y_signs = std::array<int, 3>{ 0, -1, 1 };
+
+	const auto begin = text.data();
+	const auto end = begin + text.size();
+	auto error_at = [begin](const char* pos, std::errc error) {
+		return std::unexpected(ParseError{ static_cast<size_t>(pos - begin), error });
+	};
+
+	auto commands = std::vector<uint8_t>{};
+	auto magnitudes = std::vector<int>{};
+
+	for (auto pos = begin; pos != end; ) {
+		if ('\n' == *pos || '\r' == *pos) {
+			++pos;
+			continue;
+		}
+
+		auto command = Command{};
+		switch (*pos)
+		{
+		case 'f': command = forward; break;
+		case 'u': command = up; break;
+		case 'd': command = down; break;
+		default:
+			return error_at(pos, std::errc::invalid_argument);
+		}
+
+		const auto keyword = keywords[command];
+		if (static_cast<size_t>(end - pos) < keyword.size() || 0 != std::memcmp(pos, keyword.data(), keyword.size()))
+			return error_at(pos, std::errc::invalid_argument);
+
+		pos += keyword.size();
+
+		const auto digits_begin = pos;
+		auto magnitude = int64_t{ 0 };
+		for (; pos != end && static_cast<unsigned char>(*pos - '0') < 10; ++pos) {
+			magnitude = 10 * magnitude + (*pos - '0');
+			if (magnitude > std::numeric_limits<int>::max())
+				return error_at(digits_begin, std::errc::result_out_of_range);
+		}
+
+		if (digits_begin == pos || (pos != end && '\n' != *pos && '\r' != *pos))
+			return error_at(pos, std::errc::invalid_argument);
+
+		commands.push_back(command);
+		magnitudes.push_back(static_cast<int>(magnitude));
+	}
+
+	auto out = DirectionColumns{};
+	out.x.resize(magnitudes.size());
+	out.y.resize(magnitudes.size());
+
+	for (size_t i = 0; i < magnitudes.size(); ++i) {
+		out.x[i] = x_signs[commands[i]] * magnitudes[i];
+		out.y[i] = y_signs[commands[i]] * magnitudes[i];
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename Value_T>
+Value_T checked_add(Value_T a, Value_T b)
+{
+	if ((b > 0 && a > std::numeric_limits<Value_T>::max() - b) || (b < 0 && a < std::numeric_limits<Value_T>::min() - b))
+		throw Exception("Course arithmetic overflowed");
+
+	return a + b;
+}
+
+template<typename Value_T>
+Value_T checked_multiply(Value_T a, Value_T b)
+{
+	constexpr auto max = std::numeric_limits<Value_T>::max();
+	constexpr auto min = std::numeric_limits<Value_T>::min();
+
+	const auto overflows = a > 0
+		? (b > 0 ? a > max / b : b < min / a)
+		: (b > 0 ? a < min / b : (a != 0 && b < max / a));
+
+	if (overflows)
+		throw Exception("Course arithmetic overflowed");
+
+	return a * b;
+}
+
+template<Overflow OVERFLOW, typename Value_T>
+Value_T add(Value_T a, Value_T b)
+{
+	if constexpr (Overflow::check == OVERFLOW)
+		return checked_add(a, b);
+	else
+		return wrapping_add(a, b);
+}
+
+template<Overflow OVERFLOW, typename Value_T>
+Value_T multiply(Value_T a, Value_T b)
+{
+	if constexpr (Overflow::check == OVERFLOW)
+		return checked_multiply(a, b);
+	else
+		return wrapping_multiply(a, b);
+}
+
+// An exact value of a wider type as a Value_T, checked to fit if asked to be.
+template<typename Value_T, Overflow OVERFLOW, typename Wide_T>
+Value_T narrow(Wide_T value)
+{
+	if constexpr (Overflow::check == OVERFLOW && sizeof(Value_T) < sizeof(Wide_T)) {
+		if (value < std::numeric_limits<Value_T>::min() || value > std::numeric_limits<Value_T>::max())
+			throw Exception("Course arithmetic overflowed");
+	}
+
+	return static_cast<Value_T>(value);
+}
+
+template<typename Value_T, Overflow OVERFLOW, typename Wide_T>
+BasicAiming<Value_T> narrow(const BasicAiming<Wide_T>& value)
+{
+	return { narrow<Value_T, OVERFLOW>(value.x), narrow<Value_T, OVERFLOW>(value.aim), narrow<Value_T, OVERFLOW>(value.depth) };
+}
+
+// What runs of commands that are to be combined afterwards, chunks or blocks, are reduced in.
+// Such a run's own depth or aim can be out of range even when the overall result isn't, so a
+// checked narrow type is reduced in 64 bits and narrowed once the runs have been combined; that
+// way, whether it throws doesn't depend on how the commands were grouped.
+template<typename Value_T, Overflow OVERFLOW>
+using Reduction_t = std::conditional_t<Overflow::check == OVERFLOW && sizeof(Value_T) < sizeof(int64_t), int64_t, Value_T>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline int sum_column_32(std::span<const int> column)
+{
+	auto i = size_t{ 0 };
+	auto out = 0;
+
+#if defined(AOC_HAVE_AVX2)
+	auto sums_8 = _mm256_setzero_si256();
+	for (; i + 8 <= column.size(); i += 8) {
+		sums_8 = _mm256_add_epi32(sums_8, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column.data() + i)));
+	}
+
+	alignas(32) auto lanes_8 = std::array<int, 8>{};
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes_8.data()), sums_8);
+	out = std::accumulate(lanes_8.begin(), lanes_8.end(), out, wrapping_add<int>);
+#elif defined(AOC_HAVE_SSE2)
+	auto sums_4 = _mm_setzero_si128();
+	for (; i + 4 <= column.size(); i += 4) {
+		sums_4 = _mm_add_epi32(sums_4, _mm_loadu_si128(reinterpret_cast<const __m128i*>(column.data() + i)));
+	}
+
+	alignas(16) auto lanes_4 = std::array<int, 4>{};
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes_4.data()), sums_4);
+	out = std::accumulate(lanes_4.begin(), lanes_4.end(), out, wrapping_add<int>);
+#endif
+
+	return std::accumulate(column.begin() + i, column.end(), out, wrapping_add<int>);
+}
+
+// Exact for fewer than 2^32 values, with the lanes widened to 64 bits as they're loaded. With
+// ABSOLUTE, sums the magnitudes instead.
+template<bool ABSOLUTE = false>
+int64_t sum_column_64(std::span<const int> column)
+{
+	auto i = size_t{ 0 };
+	auto out = int64_t{ 0 };
+
+#if defined(AOC_HAVE_AVX2)
+	auto sums_4 = _mm256_setzero_si256();
+	for (; i + 4 <= column.size(); i += 4) {
+		const auto values_4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column.data() + i));
+		if constexpr (ABSOLUTE)
+			sums_4 = _mm256_add_epi64(sums_4, _mm256_cvtepu32_epi64(_mm_abs_epi32(values_4)));
+		else
+			sums_4 = _mm256_add_epi64(sums_4, _mm256_cvtepi32_epi64(values_4));
+	}
+
+	alignas(32) auto lanes_4 = std::array<int64_t, 4>{};
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes_4.data()), sums_4);
+	out = std::accumulate(lanes_4.begin(), lanes_4.end(), out);
+#endif
+
+	for (; i < column.size(); ++i) {
+		const auto value = int64_t{ column[i] };
+		out += ABSOLUTE && value < 0 ? -value : value;
+	}
+
+	return out;
+}
+
+template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+Value_T sum_column(std::span<const int> column)
+{
+	if constexpr (std::is_same_v<Value_T, int> && Overflow::wrap == OVERFLOW)
+		return sum_column_32(column);
+	else
+		return narrow<Value_T, OVERFLOW>(sum_column_64(column));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(AOC_HAVE_AVX2)
+// Inclusive prefix sum of the eight lanes.
+inline __m256i prefix_sum_epi32(__m256i v)
+{
+	v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+	v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+
+	const auto low_half_total = _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(3));
+	return _mm256_add_epi32(v, _mm256_blend_epi32(_mm256_setzero_si256(), low_half_total, 0xF0));
+}
+
+// Inclusive prefix sum of the four lanes.
+inline __m256i prefix_sum_epi64(__m256i v)
+{
+	v = _mm256_add_epi64(v, _mm256_slli_si256(v, 8));
+
+	const auto low_half_total = _mm256_permute4x64_epi64(v, 0b01010101);
+	return _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_setzero_si256(), low_half_total, 0xF0));
+}
+
+// The low 64 bits of each product. AVX2 only multiplies 32-bit halves, so this is built from the
+// low-by-low product and the two cross products; the high-by-high one is shifted out entirely.
+inline __m256i mullo_epi64(__m256i a, __m256i b)
+{
+	const auto low_low = _mm256_mul_epu32(a, b);
+	const auto low_high = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+	const auto high_low = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+
+	return _mm256_add_epi64(low_low, _mm256_slli_epi64(_mm256_add_epi64(low_high, high_low), 32));
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The aim after each command is the running sum of the y deltas, and every forward move adds
+// x * aim to the depth. With AVX2 the running sum is done eight commands at a time.
+inline Aiming aiming_of_32(std::span<const int> xs, std::span<const int> ys)
+{
+	auto i = size_t{ 0 };
+	auto aim = 0;
+	auto depth = 0;
+
+#if defined(AOC_HAVE_AVX2)
+	auto aims_8 = _mm256_setzero_si256();
+	auto depths_8 = _mm256_setzero_si256();
+	for (; i + 8 <= xs.size(); i += 8) {
+		const auto x_8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs.data() + i));
+		const auto y_8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys.data() + i));
+
+		const auto running_aims = _mm256_add_epi32(aims_8, prefix_sum_epi32(y_8));
+		depths_8 = _mm256_add_epi32(depths_8, _mm256_mullo_epi32(x_8, running_aims));
+		aims_8 = _mm256_permutevar8x32_epi32(running_aims, _mm256_set1_epi32(7));
+	}
+
+	alignas(32) auto lanes_8 = std::array<int, 8>{};
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes_8.data()), depths_8);
+	depth = std::accumulate(lanes_8.begin(), lanes_8.end(), depth, wrapping_add<int>);
+	aim = _mm256_cvtsi256_si32(aims_8);
+#endif
+
+	for (; i < xs.size(); ++i) {
+		aim = wrapping_add(aim, static_cast<decltype(aim)>(ys[i]));
+		depth = wrapping_add(depth, wrapping_multiply(static_cast<decltype(depth)>(xs[i]), aim));
+	}
+
+	return { sum_column_32(xs), aim, depth };
+}
+
+// The same with 64-bit lanes, so four commands at a time.
+inline BasicAiming<int64_t> aiming_of_64(std::span<const int> xs, std::span<const int> ys)
+{
+	auto i = size_t{ 0 };
+	auto aim = int64_t{ 0 };
+	auto depth = int64_t{ 0 };
+
+#if defined(AOC_HAVE_AVX2)
+	auto aims_4 = _mm256_setzero_si256();
+	auto depths_4 = _mm256_setzero_si256();
+	for (; i + 4 <= xs.size(); i += 4) {
+		const auto x_4 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs.data() + i)));
+		const auto y_4 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys.data() + i)));
+
+		const auto running_aims = _mm256_add_epi64(aims_4, prefix_sum_epi64(y_4));
+		depths_4 = _mm256_add_epi64(depths_4, mullo_epi64(x_4, running_aims));
+		aims_4 = _mm256_permute4x64_epi64(running_aims, 0b11111111);
+	}
+
+	alignas(32) auto lanes_4 = std::array<uint64_t, 4>{};
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes_4.data()), depths_4);
+	depth = static_cast<int64_t>(std::accumulate(lanes_4.begin(), lanes_4.end(), uint64_t{ 0 }));
+	aim = _mm_cvtsi128_si64(_mm256_castsi256_si128(aims_4));
+#endif
+
+	for (; i < xs.size(); ++i) {
+		aim = wrapping_add(aim, static_cast<decltype(aim)>(ys[i]));
+		depth = wrapping_add(depth, wrapping_multiply(static_cast<decltype(depth)>(xs[i]), aim));
+	}
+
+	return { sum_column_64(xs), aim, depth };
+}
+
+// The aim never gets further from zero than the sum of the |y| deltas, so the depth stays within
+// that times the sum of the |x| deltas. If those bounds fit in max, so does every state on the way.
+inline bool aiming_fits(std::span<const int> xs, std::span<const int> ys, uint64_t max)
+{
+	const auto x_bound = static_cast<uint64_t>(sum_column_64<true>(xs));
+	const auto y_bound = static_cast<uint64_t>(sum_column_64<true>(ys));
+
+	return x_bound <= max && y_bound <= max && (0 == y_bound || x_bound <= max / y_bound);
+}
+
+template<Overflow OVERFLOW, typename Value_T>
+BasicAiming<Value_T> compose(const BasicAiming<Value_T>& first, const BasicAiming<Value_T>& next)
+{
+	if constexpr (Overflow::check == OVERFLOW) {
+		return {
+			checked_add(first.x, next.x),
+			checked_add(first.aim, next.aim),
+			checked_add(first.depth, checked_add(next.depth, checked_multiply(first.aim, next.x)))
+		};
+	}
+	else {
+		return first.then(next);
+	}
+}
+
+// The state after one more command.
+template<Overflow OVERFLOW, typename Value_T>
+BasicAiming<Value_T> step(const BasicAiming<Value_T>& state, int x, int y)
+{
+	const auto aim = add<OVERFLOW>(state.aim, static_cast<Value_T>(y));
+	return {
+		add<OVERFLOW>(state.x, static_cast<Value_T>(x)),
+		aim,
+		add<OVERFLOW>(state.depth, multiply<OVERFLOW>(static_cast<Value_T>(x), aim))
+	};
+}
+
+// One command at a time, in Value_T.
+template<typename Value_T, Overflow OVERFLOW>
+BasicAiming<Value_T> fold_aiming(std::span<const int> xs, std::span<const int> ys)
+{
+	auto out = BasicAiming<Value_T>{};
+	for (size_t i = 0; i < xs.size(); ++i) {
+		out = step<OVERFLOW>(out, xs[i], ys[i]);
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+Vec2d<Value_T> net_direction_of(const DirectionColumns& columns)
+{
+	return { detail::sum_column<Value_T, OVERFLOW>(columns.x), detail::sum_column<Value_T, OVERFLOW>(columns.y) };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Commands are aimed this many at a time when the accumulator is wider than the kernels' lanes.
+inline constexpr size_t aiming_block_size = 4096;
+
+// The aiming of a run of commands, accumulated in Value_T. int and int64_t have vectorized
+// kernels of their own. Wider types, and checked int64_t, take the commands a block at a time:
+// a block whose bounds fit in 64 bits goes through the int64_t kernel, which is then exact, and
+// the blocks are composed in Value_T. Only blocks that could overflow are folded one command at
+// a time. A checked int is aimed in 64 bits and narrowed at the end, so checking costs one pass
+// over the magnitudes for the bounds and a checked compose per block.
+template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+BasicAiming<Value_T> aiming_of(std::span<const int> xs, std::span<const int> ys)
+{
+	if constexpr (std::is_same_v<Value_T, int> && Overflow::wrap == OVERFLOW) {
+		return detail::aiming_of_32(xs, ys);
+	}
+	else if constexpr (std::is_same_v<Value_T, int64_t> && Overflow::wrap == OVERFLOW) {
+		return detail::aiming_of_64(xs, ys);
+	}
+	else if constexpr (sizeof(Value_T) < sizeof(int64_t)) {
+		return detail::narrow<Value_T, OVERFLOW>(aiming_of<int64_t, OVERFLOW>(xs, ys));
+	}
+	else {
+		auto out = BasicAiming<Value_T>{};
+		for (size_t first = 0; first < xs.size(); first += aiming_block_size) {
+			const auto block_xs = xs.subspan(first, std::min(aiming_block_size, xs.size() - first));
+			const auto block_ys = ys.subspan(first, block_xs.size());
+
+			const auto block = detail::aiming_fits(block_xs, block_ys, std::numeric_limits<int64_t>::max())
+				? detail::aiming_of_64(block_xs, block_ys).template as<Value_T>()
+				: detail::fold_aiming<Value_T, OVERFLOW>(block_xs, block_ys);
+
+			out = detail::compose<OVERFLOW>(out, block);
+		}
+
+		return out;
+	}
+}
+
+template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+Vec2d<Value_T> net_aiming_of(const DirectionColumns& columns)
+{
+	return aiming_of<Value_T, OVERFLOW>(columns.x, columns.y).to_direction();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Runs shorter than this, per thread, are aimed on the calling thread alone.
+inline constexpr size_t parallel_min_directions = size_t{ 1 } << 16;
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Each chunk's aiming from zero, for the chunks that parallel_chunks() makes of the columns, in
+// the type that aimings in Value_T are reduced in.
+template<typename Value_T, Overflow OVERFLOW>
+std::vector<CacheAligned<BasicAiming<Reduction_t<Value_T, OVERFLOW>>>> chunk_aimings(const DirectionColumns& columns, ThreadPool& pool)
+{
+	using Wide_t = Reduction_t<Value_T, OVERFLOW>;
+
+	auto out = std::vector<CacheAligned<BasicAiming<Wide_t>>>(pool.thread_count());
+
+	const auto chunk_count = parallel_chunks(pool, columns.size(), parallel_min_directions,
+		[&columns, &out](size_t chunk, size_t first, size_t last) {
+			out[chunk].value = aiming_of<Wide_t, OVERFLOW>(std::span{ columns.x }.subspan(first, last - first), std::span{ columns.y }.subspan(first, last - first));
+		});
+
+	out.resize(chunk_count);
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The chunks are reduced independently and their summaries composed in order, which gives the
+// same result as the sequential fold. Wrapping arithmetic is exact modulo 2^N, so regrouping it
+// doesn't change the result; checked arithmetic is done in Reduction_t, like the sequential fold,
+// so it throws for the same inputs.
+template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+BasicAiming<Value_T> aiming_of(const DirectionColumns& columns, ThreadPool& pool)
+{
+	const auto chunks = detail::chunk_aimings<Value_T, OVERFLOW>(columns, pool);
+	const auto wide = std::accumulate(chunks.begin(), chunks.end(), BasicAiming<detail::Reduction_t<Value_T, OVERFLOW>>{}, [](const auto& out, const auto& chunk) {
+		return detail::compose<OVERFLOW>(out, chunk.value);
+		});
+
+	return detail::narrow<Value_T, OVERFLOW>(wide);
+}
+
+// The state after every command, as a two-pass scan: the chunk summaries are composed into the
+// state each chunk starts from, then every chunk replays its commands from there.
+template<typename Value_T = int, Overflow OVERFLOW = Overflow::wrap>
+std::vector<BasicAiming<Value_T>> aiming_trajectory_of(const DirectionColumns& columns, ThreadPool& pool)
+{
+	const auto chunks = detail::chunk_aimings<Value_T, OVERFLOW>(columns, pool);
+
+	// Every start is the state after the previous chunk's last command, so it has to fit anyway.
+	auto starts = std::vector<BasicAiming<Value_T>>(chunks.size());
+	auto start = BasicAiming<detail::Reduction_t<Value_T, OVERFLOW>>{};
+	for (size_t chunk = 1; chunk < chunks.size(); ++chunk) {
+		start = detail::compose<OVERFLOW>(start, chunks[chunk - 1].value);
+		starts[chunk] = detail::narrow<Value_T, OVERFLOW>(start);
+	}
+
+	auto out = std::vector<BasicAiming<Value_T>>(columns.size());
+	parallel_chunks(pool, columns.size(), parallel_min_directions,
+		[&columns, &starts, &out](size_t chunk, size_t first, size_t last) {
+			auto state = starts[chunk];
+			for (size_t i = first; i < last; ++i) {
+				state = detail::step<OVERFLOW>(state, columns.x[i], columns.y[i]);
+				out[i] = state;
+			}
+		});
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -2,7 +2,10 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "Common.hpp"
 #include "StringOperations.hpp"
+#include "NumberParsing.hpp"
+#include "InputBuffer.hpp"
 
 #include <armadillo>
 
@@ -11,6 +14,8 @@
 #include <vector>
 #include <cstdint>
 #include <optional>
+#include <span>
+#include <format>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -44,15 +49,68 @@ public:
 
 	Size_t size() const { return _values.size(); }
 
-	void load(std::istream& stream)
+	void load(std::istream& stream, ParseStrategy strategy = ParseStrategy::tokenized)
 	{
 		auto line = std::string{};
 		std::getline(stream, line);
 
-		const auto value_strings = split(line, ',');
+		const auto error = _load(line, strategy);
+		if (std::errc{} != error) {
+			stream.setstate(std::ios::failbit);
+			throw Exception(std::format("Failed to read bingo draws from stream: {}", conversion_error_message(error)));
+		}
+	}
+
+	void load(std::string_view line, ParseStrategy strategy = ParseStrategy::tokenized)
+	{
+		const auto error = _load(line, strategy);
+		if (std::errc{} != error) {
+			throw Exception(std::format("Failed to read bingo draws: {}", conversion_error_message(error)));
+		}
+	}
+
+	void load(std::span<const Value_t> values)
+	{
+		_values.assign(values.begin(), values.end());
+	}
+
+private:
+
+	std::errc _load(std::string_view line, ParseStrategy strategy)
+	{
+		_values.clear();
+		_values.reserve(std::count(line.begin(), line.end(), ',') + 1);
+
+		const auto error = ParseStrategy::vectorized == strategy ? _load_vectorized(line) : _load_tokenized(line);
+		if (std::errc{} != error) {
+			_values.clear();
+		}
+
+		return error;
+	}
+
+	std::errc _load_tokenized(std::string_view line)
+	{
+		for (const auto value_str : split_view(line, ',')) {
+			const auto value = try_string_to<Value_t>(value_str);
+			if (!value)
+				return value.error();
+
+			_values.push_back(*value);
+		}
+
+		return {};
+	}
 
-		_values.resize(value_strings.size(), 0);
-		std::transform(value_strings.begin(), value_strings.end(), _values.begin(), [](auto s) { return static_cast<Value_t>(std::stol(s)); });
+	std::errc _load_vectorized(std::string_view line)
+	{
+		return for_each_csv_uint32(line, [this](uint32_t value) {
+			if (value > std::numeric_limits<Value_t>::max())
+				return false;
+
+			_values.push_back(static_cast<Value_t>(value));
+			return true;
+			});
 	}
 };
 
@@ -100,6 +158,36 @@ public:
 		return *this;
 	}
 
+	Board& load(LineReader& reader)
+	{
+		for (auto row = 0; row < _numbers.n_rows; ++row) {
+			const auto line = reader.next();
+			if (!line) {
+				throw Exception("Invalid bingo board size board");
+			}
+
+			_load_row(*line, row);
+		}
+
+		return *this;
+	}
+
+	// Cells row by row
+	Board& load(std::span<const uint8_t> cells)
+	{
+		if (cells.size() != _numbers.n_elem) {
+			throw Exception("Invalid bingo board size board");
+		}
+
+		for (auto row = 0; row < _numbers.n_rows; ++row) {
+			for (auto col = 0; col < _numbers.n_cols; ++col) {
+				_numbers(row, col) = Cell{ cells[row * _numbers.n_cols + col], false };
+			}
+		}
+
+		return *this;
+	}
+
 	bool mark(uint8_t number)
 	{
 		auto cell = _find(number);
@@ -180,13 +268,13 @@ private:
 
 	Cell* _find(uint8_t number) { return const_cast<Cell*>(const_cast<const Board*>(this)->_find(number)); }
 
-	static Cell _string_to_cell(const std::string& str)
+	static Cell _string_to_cell(std::string_view str)
 	{
-		const auto value = std::stol(str);
-		if (value > std::numeric_limits<uint8_t>::max())
+		const auto value = try_string_to<uint8_t>(str);
+		if (!value)
 			throw Exception("Invalid board value");
 
-		return Cell{ static_cast<uint8_t>(value), false };
+		return Cell{ *value, false };
 	}
 
 	void _load_row(std::istream& stream, size_t row_idx)
@@ -194,14 +282,23 @@ private:
 		auto line = std::string{};
 		std::getline(stream, line);
 
-		const auto value_strings = split(line, ' ', SplitBehaviour::drop_empty);
-		if (value_strings.size() != _numbers.n_cols) {
-			throw Exception("Invalid bingo board size board");
-		}
+		_load_row(line, row_idx);
+	}
 
+	void _load_row(std::string_view line, size_t row_idx)
+	{
 		auto row = _numbers.row(row_idx);
-		for (size_t idx = 0; idx < row.n_elem; ++idx) {
-			row[idx] = _string_to_cell(value_strings[idx]);
+		auto idx = size_t{ 0 };
+		for (const auto value_str : split_view(line, ' ', SplitBehaviour::drop_empty)) {
+			if (idx == row.n_elem) {
+				throw Exception("Invalid bingo board size board");
+			}
+
+			row[idx++] = _string_to_cell(value_str);
+		}
+
+		if (idx != row.n_elem) {
+			throw Exception("Invalid bingo board size board");
 		}
 	}
 
@@ -289,6 +386,40 @@ public:
 		return *this;
 	}
 
+	Game& load(const InputBuffer& buffer)
+	{
+		auto reader = LineReader{ buffer };
+
+		_drawer.load(reader.next().value_or(std::string_view{}));
+		_load_boards(reader);
+
+		_assign_boards_to_players();
+
+		return *this;
+	}
+
+	// Draws and board cells as stored in a ParsedCache; each board is 25 cells, row by row. The
+	// draws and cells aren't parsed again, but they are copied: the boards are built from the cells,
+	// as a board keeps the marks of the game played on it.
+	Game& load(std::span<const uint8_t> draws, std::span<const uint8_t> cells)
+	{
+		constexpr auto board_cells = size_t{ 5 * 5 };
+		if (cells.size() % board_cells != 0) {
+			throw Exception("Invalid bingo board size board");
+		}
+
+		_drawer.load(draws);
+
+		_boards.clear();
+		for (auto board_id = Board::Id_t{ 0 }; board_id < cells.size() / board_cells; ++board_id) {
+			_load_board(board_id, cells.subspan(board_id * board_cells, board_cells));
+		}
+
+		_assign_boards_to_players();
+
+		return *this;
+	}
+
 	Game& play_to_win()
 	{
 		_winning_player = _players.end();
@@ -386,10 +517,20 @@ private:
 		}
 	}
 
-	void _load_board(const Board::Id_t& id, std::istream& stream)
+	void _load_boards(LineReader& reader)
+	{
+		auto board_id = Board::Id_t{ 0 };
+		while (_skip_blank_line(reader))
+		{
+			_load_board(board_id++, reader);
+		}
+	}
+
+	template<typename Source_T>
+	void _load_board(const Board::Id_t& id, Source_T&& source)
 	{
 		auto board = Board{ id, 5 };
-		board.load(stream);
+		board.load(source);
 		_boards.push_back(std::move(board));
 	}
 
@@ -404,6 +545,18 @@ private:
 		return !stream.eof();
 	}
 
+	bool _skip_blank_line(LineReader& reader)
+	{
+		const auto line = reader.next();
+		if (!line)
+			return false;
+
+		if (!line->empty())
+			throw Exception(std::format("Line that should have been blank actually contained \"{}\"", *line));
+
+		return !reader.at_end();
+	}
+
 	NumberDrawer_T _drawer;
 	Boards_t _boards;
 	Players_t _players;
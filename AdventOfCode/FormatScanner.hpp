@@ -0,0 +1,451 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Where, and why, parsing of a text input stopped. The offset is in bytes from the start of the input.
+struct ParseError
+{
+	size_t offset;
+	std::errc error;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A string literal that can be used as a template argument.
+template<size_t N>
+struct FormatString
+{
+	constexpr FormatString(const char (&str)[N])
+	{
+		std::copy_n(str, N, chars);
+	}
+
+	constexpr std::string_view view() const { return { chars, N - 1 }; }
+
+	char chars[N]{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum class FormatTokenKind : uint8_t
+{
+	literal,
+	number,
+	word,
+	bits,
+};
+
+struct FormatToken
+{
+	FormatTokenKind kind{ FormatTokenKind::literal };
+
+	// The literal text, or the word alternatives, as a range of the format string.
+	size_t begin{ 0 };
+	size_t length{ 0 };
+
+	// Numbers: 0 bytes means the scanner's default number type.
+	bool is_signed{ false };
+	size_t bytes{ 0 };
+
+	// Bits: the exact number of '0'/'1' characters.
+	size_t width{ 0 };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Not constexpr, so reaching it while tokenizing a format is a compile error.
+inline void invalid_format(const char*) {}
+
+///////////////////////////////////////////////////////////////////////////////
+
+constexpr FormatToken make_field_token(std::string_view format, size_t begin, size_t length)
+{
+	const auto spec = format.substr(begin, length);
+
+	auto out = FormatToken{};
+	if (spec.empty()) {
+		out.kind = FormatTokenKind::number;
+		return out;
+	}
+
+	if (spec.starts_with("word:")) {
+		out.kind = FormatTokenKind::word;
+		out.begin = begin + 5;
+		out.length = length - 5;
+		if (0 == out.length)
+			invalid_format("A word field needs at least one alternative");
+
+		return out;
+	}
+
+	if (spec.starts_with("bits:")) {
+		out.kind = FormatTokenKind::bits;
+		for (const auto c : spec.substr(5)) {
+			if (c < '0' || c > '9')
+				invalid_format("A bits field needs a width");
+
+			out.width = 10 * out.width + (c - '0');
+		}
+
+		if (0 == out.width || out.width > 64)
+			invalid_format("A bits field is between 1 and 64 bits wide");
+
+		return out;
+	}
+
+	constexpr auto number_specs = std::array<std::string_view, 8>{ "u8", "u16", "u32", "u64", "i8", "i16", "i32", "i64" };
+	for (size_t i = 0; i < number_specs.size(); ++i) {
+		if (number_specs[i] == spec) {
+			out.kind = FormatTokenKind::number;
+			out.is_signed = i >= 4;
+			out.bytes = size_t{ 1 } << (i % 4);
+			return out;
+		}
+	}
+
+	invalid_format("Unknown field type");
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Splits a format into literal runs and "{...}" fields. With out == nullptr, just counts them.
+constexpr size_t tokenize_format(std::string_view format, FormatToken* out)
+{
+	auto count = size_t{ 0 };
+	auto emit = [&](const FormatToken& token) {
+		if (out)
+			out[count] = token;
+
+		++count;
+	};
+
+	for (size_t pos = 0; pos < format.size(); ) {
+		if ('{' == format[pos]) {
+			const auto close = format.find('}', pos);
+			if (std::string_view::npos == close)
+				invalid_format("Unterminated field");
+
+			emit(make_field_token(format, pos + 1, close - pos - 1));
+			pos = close + 1;
+		}
+		else {
+			const auto next_field = std::min(format.find('{', pos), format.size());
+			if (std::string_view::npos != format.substr(pos, next_field - pos).find('}'))
+				invalid_format("Unmatched '}'");
+
+			emit(FormatToken{ FormatTokenKind::literal, pos, next_field - pos });
+			pos = next_field;
+		}
+	}
+
+	return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename Number_T, FormatToken TOKEN>
+struct FormatFieldValue
+{
+	using type = Number_T;
+};
+
+template<typename Number_T, FormatToken TOKEN>
+	requires (FormatTokenKind::number == TOKEN.kind && TOKEN.bytes > 0)
+struct FormatFieldValue<Number_T, TOKEN>
+{
+	using Unsigned_t = std::conditional_t<1 == TOKEN.bytes, uint8_t,
+		std::conditional_t<2 == TOKEN.bytes, uint16_t,
+		std::conditional_t<4 == TOKEN.bytes, uint32_t, uint64_t>>>;
+
+	using type = std::conditional_t<TOKEN.is_signed, std::make_signed_t<Unsigned_t>, Unsigned_t>;
+};
+
+// Index of the matching alternative
+template<typename Number_T, FormatToken TOKEN>
+	requires (FormatTokenKind::word == TOKEN.kind)
+struct FormatFieldValue<Number_T, TOKEN>
+{
+	using type = uint8_t;
+};
+
+// Packed, first character most significant
+template<typename Number_T, FormatToken TOKEN>
+	requires (FormatTokenKind::bits == TOKEN.kind)
+struct FormatFieldValue<Number_T, TOKEN>
+{
+	using type = uint64_t;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline bool is_format_blank(char c)
+{
+	return ' ' == c || '\t' == c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Scanner generated at compile time from a format description such as
+//
+//     "{u32},{u32} -> {u32},{u32}"   or   "{word:forward|up|down} {i32}"
+//
+// Fields are {u8|u16|u32|u64|i8|i16|i32|i64}, or {} for Number_T; {word:a|b|...}, which yields the
+// index of the first alternative that matches; and {bits:N}, exactly N '0'/'1' characters packed
+// into a uint64_t. Numbers may be preceded by blanks, and a blank in the literal text matches a
+// run of one or more blanks. A record has to be consumed completely, apart from trailing blanks.
+// Nothing is allocated.
+template<FormatString FORMAT, typename Number_T = uint32_t>
+	requires std::integral<Number_T>
+class FormatScanner
+{
+	static constexpr auto _token_count = detail::tokenize_format(FORMAT.view(), nullptr);
+
+	static constexpr auto _tokens = []() {
+		auto out = std::array<detail::FormatToken, _token_count>{};
+		detail::tokenize_format(FORMAT.view(), out.data());
+		return out;
+	}();
+
+	static constexpr size_t _field_index(size_t token_index)
+	{
+		return static_cast<size_t>(std::count_if(_tokens.begin(), _tokens.begin() + token_index, [](const auto& token) {
+			return detail::FormatTokenKind::literal != token.kind;
+			}));
+	}
+
+	static constexpr auto _field_count = _field_index(_token_count);
+
+	static constexpr auto _fields = []() {
+		auto out = std::array<detail::FormatToken, _field_count>{};
+		std::copy_if(_tokens.begin(), _tokens.end(), out.begin(), [](const auto& token) {
+			return detail::FormatTokenKind::literal != token.kind;
+			});
+		return out;
+	}();
+
+	template<size_t... FIELDS>
+	static auto _values_type(std::index_sequence<FIELDS...>)
+		-> std::tuple<typename detail::FormatFieldValue<Number_T, _fields[FIELDS]>::type...>;
+
+public:
+	using Values_t = decltype(_values_type(std::make_index_sequence<_field_count>{}));
+
+	// Offsets in errors are from the start of the record.
+	static std::expected<Values_t, ParseError> scan(std::string_view record)
+	{
+		const auto begin = record.data();
+		const auto end = begin + record.size();
+
+		auto pos = begin;
+		auto values = Values_t{};
+
+		auto error = _scan_tokens(pos, end, values, std::make_index_sequence<_token_count>{});
+		if (std::errc{} == error) {
+			while (pos != end && detail::is_format_blank(*pos))
+				++pos;
+
+			if (pos != end)
+				error = std::errc::invalid_argument;
+		}
+
+		if (std::errc{} != error)
+			return std::unexpected(ParseError{ static_cast<size_t>(pos - begin), error });
+
+		return values;
+	}
+
+	// Scans every line of text, skipping blank ones, and calls sink with the fields of each.
+	// Offsets in errors are from the start of the text.
+	template<typename Sink_T>
+	static std::expected<void, ParseError> for_each(std::string_view text, Sink_T&& sink)
+	{
+		for (size_t line_begin = 0; line_begin < text.size(); ) {
+			const auto newline = text.find('\n', line_begin);
+			const auto line_end = std::string_view::npos == newline ? text.size() : newline;
+
+			auto line = text.substr(line_begin, line_end - line_begin);
+			if (line.ends_with('\r'))
+				line.remove_suffix(1);
+
+			if (!line.empty()) {
+				const auto values = scan(line);
+				if (!values)
+					return std::unexpected(ParseError{ line_begin + values.error().offset, values.error().error });
+
+				std::apply(sink, *values);
+			}
+
+			line_begin = line_end + 1;
+		}
+
+		return {};
+	}
+
+private:
+
+	template<size_t... TOKENS>
+	static std::errc _scan_tokens(const char*& pos, const char* end, Values_t& values, std::index_sequence<TOKENS...>)
+	{
+		auto error = std::errc{};
+		((error = _scan_token<TOKENS>(pos, end, values), std::errc{} == error) && ...);
+
+		return error;
+	}
+
+	template<size_t TOKEN>
+	static std::errc _scan_token(const char*& pos, const char* end, Values_t& values)
+	{
+		constexpr auto token = _tokens[TOKEN];
+
+		if constexpr (detail::FormatTokenKind::literal == token.kind) {
+			return _scan_literal<TOKEN>(pos, end);
+		}
+		else if constexpr (detail::FormatTokenKind::number == token.kind) {
+			return _scan_number(pos, end, std::get<_field_index(TOKEN)>(values));
+		}
+		else if constexpr (detail::FormatTokenKind::word == token.kind) {
+			return _scan_word<TOKEN>(pos, end, std::get<_field_index(TOKEN)>(values));
+		}
+		else {
+			return _scan_bits<token.width>(pos, end, std::get<_field_index(TOKEN)>(values));
+		}
+	}
+
+	static constexpr std::string_view _token_text(size_t token_index)
+	{
+		return FORMAT.view().substr(_tokens[token_index].begin, _tokens[token_index].length);
+	}
+
+	template<size_t TOKEN>
+	static std::errc _scan_literal(const char*& pos, const char* end)
+	{
+		constexpr auto literal = _token_text(TOKEN);
+		for (const auto c : literal) {
+			if (' ' == c) {
+				if (pos == end || !detail::is_format_blank(*pos))
+					return std::errc::invalid_argument;
+
+				while (pos != end && detail::is_format_blank(*pos))
+					++pos;
+			}
+			else {
+				if (pos == end || c != *pos)
+					return std::errc::invalid_argument;
+
+				++pos;
+			}
+		}
+
+		return {};
+	}
+
+	template<typename Value_T>
+	static std::errc _scan_number(const char*& pos, const char* end, Value_T& value)
+	{
+		while (pos != end && detail::is_format_blank(*pos))
+			++pos;
+
+		const auto number_begin = pos;
+
+		const auto negative = std::is_signed_v<Value_T> && pos != end && '-' == *pos;
+		if (negative)
+			++pos;
+
+		const auto limit = static_cast<uint64_t>(std::numeric_limits<Value_T>::max()) + (negative ? 1 : 0);
+
+		const auto digits_begin = pos;
+		auto magnitude = uint64_t{ 0 };
+		for (; pos != end && static_cast<unsigned char>(*pos - '0') < 10; ++pos) {
+			const auto digit = static_cast<uint64_t>(*pos - '0');
+			if (magnitude > (limit - digit) / 10) {
+				pos = number_begin;
+				return std::errc::result_out_of_range;
+			}
+
+			magnitude = 10 * magnitude + digit;
+		}
+
+		if (digits_begin == pos)
+			return std::errc::invalid_argument;
+
+		value = static_cast<Value_T>(negative ? 0 - magnitude : magnitude);
+
+		return {};
+	}
+
+	template<size_t TOKEN>
+	static std::errc _scan_word(const char*& pos, const char* end, uint8_t& value)
+	{
+		constexpr auto alternatives = _token_text(TOKEN);
+
+		auto index = uint8_t{ 0 };
+		for (size_t alternative_begin = 0; alternative_begin <= alternatives.size(); ++index) {
+			const auto alternative_end = std::min(alternatives.find('|', alternative_begin), alternatives.size());
+			const auto alternative = alternatives.substr(alternative_begin, alternative_end - alternative_begin);
+
+			if (static_cast<size_t>(end - pos) >= alternative.size() && std::equal(alternative.begin(), alternative.end(), pos)) {
+				pos += alternative.size();
+				value = index;
+				return {};
+			}
+
+			alternative_begin = alternative_end + 1;
+		}
+
+		return std::errc::invalid_argument;
+	}
+
+	template<size_t WIDTH>
+	static std::errc _scan_bits(const char*& pos, const char* end, uint64_t& value)
+	{
+		if (static_cast<size_t>(end - pos) < WIDTH)
+			return std::errc::invalid_argument;
+
+		value = 0;
+		for (size_t i = 0; i < WIDTH; ++i, ++pos) {
+			const auto bit = static_cast<unsigned char>(*pos - '0');
+			if (bit > 1)
+				return std::errc::invalid_argument;
+
+			value = (value << 1) | bit;
+		}
+
+		return {};
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
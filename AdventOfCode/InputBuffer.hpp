@@ -0,0 +1,222 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Read-only, memory-mapped view of a whole input file. The loaders parse straight out of the
+// mapping, so there's no stream buffering or copying on the way in.
+class InputBuffer
+{
+public:
+	explicit InputBuffer(const std::filesystem::path& path)
+	{
+		_map(path);
+	}
+
+	InputBuffer(const InputBuffer&) = delete;
+	InputBuffer& operator=(const InputBuffer&) = delete;
+
+	InputBuffer(InputBuffer&& other) noexcept
+		: _data{ std::exchange(other._data, nullptr) }
+		, _size{ std::exchange(other._size, 0) }
+	{}
+
+	InputBuffer& operator=(InputBuffer&& other) noexcept
+	{
+		if (this != &other) {
+			_unmap();
+			_data = std::exchange(other._data, nullptr);
+			_size = std::exchange(other._size, 0);
+		}
+
+		return *this;
+	}
+
+	~InputBuffer()
+	{
+		_unmap();
+	}
+
+	const char* data() const { return _data; }
+	size_t size() const { return _size; }
+	bool empty() const { return 0 == _size; }
+
+	const char* begin() const { return _data; }
+	const char* end() const { return _data + _size; }
+
+	std::string_view view() const { return { _data, _size }; }
+
+private:
+
+#if defined(_WIN32)
+	void _map(const std::filesystem::path& path)
+	{
+		const auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (INVALID_HANDLE_VALUE == file) {
+			throw Exception(std::format("Failed to open {}", path.string()));
+		}
+
+		auto file_size = LARGE_INTEGER{};
+		if (!::GetFileSizeEx(file, &file_size)) {
+			::CloseHandle(file);
+			throw Exception(std::format("Failed to get the size of {}", path.string()));
+		}
+
+		// Empty files can't be mapped, but they're still valid (empty) input.
+		if (0 == file_size.QuadPart) {
+			::CloseHandle(file);
+			return;
+		}
+
+		const auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		::CloseHandle(file);
+		if (nullptr == mapping) {
+			throw Exception(std::format("Failed to map {}", path.string()));
+		}
+
+		// The view keeps the mapping alive, so the handle isn't needed after this.
+		const auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		::CloseHandle(mapping);
+		if (nullptr == view) {
+			throw Exception(std::format("Failed to map {}", path.string()));
+		}
+
+		_data = static_cast<const char*>(view);
+		_size = static_cast<size_t>(file_size.QuadPart);
+	}
+
+	void _unmap()
+	{
+		if (_data) {
+			::UnmapViewOfFile(_data);
+		}
+
+		_data = nullptr;
+		_size = 0;
+	}
+#else
+	void _map(const std::filesystem::path& path)
+	{
+		const auto fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw Exception(std::format("Failed to open {}", path.string()));
+		}
+
+		struct stat file_stat {};
+		if (::fstat(fd, &file_stat) != 0) {
+			::close(fd);
+			throw Exception(std::format("Failed to get the size of {}", path.string()));
+		}
+
+		// Empty files can't be mapped, but they're still valid (empty) input.
+		if (0 == file_stat.st_size) {
+			::close(fd);
+			return;
+		}
+
+		const auto size = static_cast<size_t>(file_stat.st_size);
+		const auto view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (MAP_FAILED == view) {
+			throw Exception(std::format("Failed to map {}", path.string()));
+		}
+
+		::madvise(view, size, MADV_SEQUENTIAL);
+
+		_data = static_cast<const char*>(view);
+		_size = size;
+	}
+
+	void _unmap()
+	{
+		if (_data) {
+			::munmap(const_cast<char*>(_data), _size);
+		}
+
+		_data = nullptr;
+		_size = 0;
+	}
+#endif
+
+	const char* _data{ nullptr };
+	size_t _size{ 0 };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Hands out the lines of a buffer one at a time, without the line terminators ("\n" or "\r\n").
+class LineReader
+{
+public:
+	explicit LineReader(std::string_view text)
+		: _text{ text }
+	{}
+
+	explicit LineReader(const InputBuffer& buffer)
+		: LineReader{ buffer.view() }
+	{}
+
+	bool at_end() const { return _offset == _text.size(); }
+
+	// Offset of the next line from the start of the buffer.
+	size_t offset() const { return _offset; }
+
+	std::optional<std::string_view> next()
+	{
+		if (at_end())
+			return std::nullopt;
+
+		const auto newline = _text.find('\n', _offset);
+		const auto line_end = std::string_view::npos == newline ? _text.size() : newline;
+
+		auto line = _text.substr(_offset, line_end - _offset);
+		if (!line.empty() && '\r' == line.back()) {
+			line.remove_suffix(1);
+		}
+
+		_offset = std::string_view::npos == newline ? _text.size() : newline + 1;
+
+		return line;
+	}
+
+private:
+	std::string_view _text;
+	size_t _offset{ 0 };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -3,6 +3,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "StringOperations.hpp"
+#include "NumberParsing.hpp"
+#include "InputBuffer.hpp"
+#include "StreamingInput.hpp"
 #include "Common.hpp"
 
 #include <cstdint>
@@ -75,25 +78,28 @@ public:
 	using Iterator_t = decltype(_fish.begin());
 	using ConstIterator_t = decltype(_fish.cbegin());
 
-	LanternfishShoal& load(std::istream& stream) try
+	LanternfishShoal& load(std::istream& stream, ParseStrategy strategy = ParseStrategy::tokenized)
 	{
-		_load(stream);
+		auto str = std::string{};
+		std::getline(stream, str);
+
+		const auto error = _load(str, strategy);
+		if (std::errc{} != error) {
+			stream.setstate(std::ios::failbit);
+			throw Exception(std::format("Failed to read Lanternfish shoal from stream: {}", conversion_error_message(error)));
+		}
+
 		return *this;
 	}
-	catch (const std::invalid_argument&)
-	{
-		stream.setstate(std::ios::failbit);
-		throw Exception("Failed to read Lanternfish shoal from stream: Non-numeric character");
-	}
-	catch (const std::out_of_range&)
-	{
-		stream.setstate(std::ios::failbit);
-		throw Exception("Failed to read Lanternfish shoal from stream: Value out-of-range");
-	}
-	catch (const Exception&)
+
+	LanternfishShoal& load(const InputBuffer& buffer, ParseStrategy strategy = ParseStrategy::tokenized)
 	{
-		stream.setstate(std::ios::failbit);
-		throw Exception("Failed to read Lanternfish shoal from stream: Value out-of-range");
+		const auto error = _load(LineReader{ buffer }.next().value_or(std::string_view{}), strategy);
+		if (std::errc{} != error) {
+			throw Exception(std::format("Failed to read Lanternfish shoal: {}", conversion_error_message(error)));
+		}
+
+		return *this;
 	}
 
 	Size_t size() const { return _fish.size(); }
@@ -106,16 +112,43 @@ public:
 
 private:
 
-	void _load(std::istream& stream)
+	std::errc _load(std::string_view str, ParseStrategy strategy)
 	{
-		auto str = std::string{};
-		std::getline(stream, str);
+		_fish.clear();
+		_fish.reserve(std::count(str.begin(), str.end(), ',') + 1);
+
+		const auto error = ParseStrategy::vectorized == strategy ? _load_vectorized(str) : _load_tokenized(str);
+		if (std::errc{} != error) {
+			_fish.clear();
+		}
+
+		return error;
+	}
+
+	std::errc _load_tokenized(std::string_view str)
+	{
+		for (const auto spawning_time_str : split_view(str, ',')) {
+			const auto spawning_time = try_string_to<uint32_t>(spawning_time_str);
+			if (!spawning_time)
+				return spawning_time.error();
+
+			if (*spawning_time > Lanternfish::max_days_until_spawning)
+				return std::errc::result_out_of_range;
+
+			_fish.emplace_back(*spawning_time);
+		}
 
-		const auto spawning_times = split(str, ',');
-		_fish.resize(spawning_times.size());
+		return {};
+	}
+
+	std::errc _load_vectorized(std::string_view str)
+	{
+		return for_each_csv_uint32(str, [this](uint32_t spawning_time) {
+			if (spawning_time > Lanternfish::max_days_until_spawning)
+				return false;
 
-		std::transform(spawning_times.begin(), spawning_times.end(), _fish.begin(), [](const auto& s) {
-			return Lanternfish{ string_to<uint32_t>(s) };
+			_fish.emplace_back(spawning_time);
+			return true;
 			});
 	}
 };
@@ -133,6 +166,50 @@ public:
 			});
 	}
 
+	// Builds the model straight from the serialized shoal, without materializing the individual fish.
+	explicit LanternfishShoalModel(std::istream& stream)
+	{
+		auto str = std::string{};
+		std::getline(stream, str);
+
+		const auto fish_counts = _parse_fish_counts(str);
+		if (!fish_counts) {
+			stream.setstate(std::ios::failbit);
+			throw Exception(std::format("Failed to read Lanternfish shoal from stream: {}", conversion_error_message(fish_counts.error())));
+		}
+
+		_fish_counts = *fish_counts;
+	}
+
+	explicit LanternfishShoalModel(const InputBuffer& buffer)
+	{
+		const auto fish_counts = _parse_fish_counts(LineReader{ buffer }.next().value_or(std::string_view{}));
+		if (!fish_counts) {
+			throw Exception(std::format("Failed to read Lanternfish shoal: {}", conversion_error_message(fish_counts.error())));
+		}
+
+		_fish_counts = *fish_counts;
+	}
+
+	// Counts the fish as the shoal streams past, without holding on to the input.
+	explicit LanternfishShoalModel(StreamingInput& input)
+		: _fish_counts{}
+	{
+		input.for_each_block(',', [this](std::string_view block, size_t offset) {
+			const auto error = for_each_csv_uint32(block, [this](uint32_t spawning_time) {
+				if (spawning_time >= _fish_counts.size())
+					return false;
+
+				++_fish_counts[spawning_time];
+				return true;
+				});
+
+			if (std::errc{} != error) {
+				throw Exception(std::format("Failed to read Lanternfish shoal after byte offset {}: {}", offset, conversion_error_message(error)));
+			}
+			});
+	}
+
 	LanternfishShoalModel& run_for(std::chrono::days run_time)
 	{
 		while (run_time-- > std::chrono::days{ 0 }) {
@@ -145,6 +222,13 @@ public:
 
 private:
 
+	using FishCounts_t = std::array<LanternfishShoal::Size_t, Lanternfish::max_days_until_spawning + 1>;
+
+	static std::expected<FishCounts_t, std::errc> _parse_fish_counts(std::string_view str)
+	{
+		return parse_csv_histogram<std::tuple_size_v<FishCounts_t>, LanternfishShoal::Size_t>(str);
+	}
+
 	void _step()
 	{
 		const auto zero_day_fish_count = _fish_counts[0];
@@ -153,7 +237,7 @@ private:
 		_fish_counts[Lanternfish::days_until_spawning_reset_value] += zero_day_fish_count;
 	}
 
-	std::array<LanternfishShoal::Size_t, Lanternfish::max_days_until_spawning + 1> _fish_counts;
+	FishCounts_t _fish_counts;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
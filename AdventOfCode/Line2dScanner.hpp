@@ -0,0 +1,68 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+#include "FormatScanner.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Single-pass scanner for "x,y -> x,y" records, one per line. Blank lines are skipped and "\r\n"
+// line endings are accepted. Nothing is allocated apart from the output array.
+template<typename Value_T>
+	requires std::integral<Value_T> && (sizeof(Value_T) <= sizeof(uint32_t))
+class Line2dScanner
+{
+public:
+	using Value_t = Value_T;
+	using Line_t = Line2d<Value_t>;
+	using Format_t = FormatScanner<"{},{} -> {},{}", Value_t>;
+
+	explicit Line2dScanner(std::string_view text)
+		: _text{ text }
+	{}
+
+	std::expected<std::vector<Line_t>, ParseError> scan_all()
+	{
+		auto out = std::vector<Line_t>{};
+
+		const auto result = Format_t::for_each(_text, [&out](Value_t x0, Value_t y0, Value_t x1, Value_t y1) {
+			out.push_back(Line_t{ Vec2d<Value_t>{ x0, y0 }, Vec2d<Value_t>{ x1, y1 } });
+			});
+
+		if (!result)
+			return std::unexpected(result.error());
+
+		return out;
+	}
+
+private:
+	std::string_view _text;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename Value_T>
+std::expected<std::vector<Line2d<Value_T>>, ParseError> scan_line2ds(std::string_view text)
+{
+	return Line2dScanner<Value_T>{ text }.scan_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
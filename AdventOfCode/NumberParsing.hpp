@@ -0,0 +1,202 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Simd.hpp"
+#include "StringOperations.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <expected>
+#include <system_error>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum class ParseStrategy
+{
+	tokenized,
+	vectorized
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline bool is_blank(char c)
+{
+	return ' ' == c || '\t' == c || '\r' == c || '\n' == c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Numbers of up to 8 digits are converted in a single 64-bit word (SWAR); anything longer goes
+// through from_chars.
+inline std::expected<uint32_t, std::errc> csv_token_to_uint32(const char* begin, const char* end)
+{
+	while (begin != end && is_blank(*begin))
+		++begin;
+
+	while (end != begin && is_blank(*(end - 1)))
+		--end;
+
+	const auto length = static_cast<size_t>(end - begin);
+	if (0 == length || length > 8) {
+		return try_string_to<uint32_t>(std::string_view{ begin, length });
+	}
+
+	// Right-align the digits in the word, so that the padding reads as leading zeros.
+	auto word = uint64_t{ 0x3030303030303030 };
+	std::memcpy(reinterpret_cast<char*>(&word) + (8 - length), begin, length);
+
+	const auto high_nibbles = word & 0xF0F0F0F0F0F0F0F0;
+	const auto overflowed_low_nibbles = ((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4;
+	if ((high_nibbles | overflowed_low_nibbles) != 0x3333333333333333) {
+		return std::unexpected(std::errc::invalid_argument);
+	}
+
+	word = ((word & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+	word = ((word & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+	word = ((word & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+
+	return static_cast<uint32_t>(word);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Calls sink(value) for every comma-separated number in text; sink returns false to reject a value,
+// which is reported as std::errc::result_out_of_range. The separators are located 32 (AVX2) or
+// 16 (SSE2) bytes at a time and each number is converted without a per-digit loop.
+template<typename Sink_T>
+std::errc for_each_csv_uint32(std::string_view text, Sink_T&& sink)
+{
+	const auto first = std::find_if_not(text.begin(), text.end(), detail::is_blank);
+	const auto last = std::find_if_not(text.rbegin(), std::make_reverse_iterator(first), detail::is_blank).base();
+	if (first == last) {
+		return {};
+	}
+
+	const char* const end = text.data() + std::distance(text.begin(), last);
+	const char* pos = text.data() + std::distance(text.begin(), first);
+	const char* token = pos;
+
+	auto error = std::errc{};
+	auto emit = [&](const char* token_end) {
+		const auto value = detail::csv_token_to_uint32(token, token_end);
+		if (!value) {
+			error = value.error();
+		}
+		else if (!sink(*value)) {
+			error = std::errc::result_out_of_range;
+		}
+
+		token = token_end + 1;
+
+		return std::errc{} == error;
+	};
+
+	auto emit_for_mask = [&](const char* block, uint32_t separator_mask) {
+		for (; 0 != separator_mask; separator_mask &= separator_mask - 1) {
+			if (!emit(block + std::countr_zero(separator_mask)))
+				return false;
+		}
+
+		return true;
+	};
+
+#if defined(AOC_HAVE_AVX2)
+	const auto commas_32 = _mm256_set1_epi8(',');
+	for (; end - pos >= 32; pos += 32) {
+		const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+		const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, commas_32)));
+		if (!emit_for_mask(pos, mask))
+			return error;
+	}
+#endif
+
+#if defined(AOC_HAVE_SSE2)
+	const auto commas_16 = _mm_set1_epi8(',');
+	for (; end - pos >= 16; pos += 16) {
+		const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+		const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, commas_16)));
+		if (!emit_for_mask(pos, mask))
+			return error;
+	}
+#endif
+
+	for (; pos != end; ++pos) {
+		if (',' == *pos && !emit(pos))
+			return error;
+	}
+
+	// Like split(), a trailing separator doesn't start another (empty) value.
+	if (token != end) {
+		emit(end);
+	}
+
+	return error;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline std::expected<std::vector<uint32_t>, std::errc> parse_csv_uint32s(std::string_view text)
+{
+	auto out = std::vector<uint32_t>{};
+	out.reserve(std::count(text.begin(), text.end(), ',') + 1);
+
+	const auto error = for_each_csv_uint32(text, [&out](uint32_t value) {
+		out.push_back(value);
+		return true;
+		});
+
+	if (std::errc{} != error) {
+		return std::unexpected(error);
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Counts how many times each value in [0, BINS) appears; larger values are out-of-range.
+template<size_t BINS, typename Count_T = size_t>
+std::expected<std::array<Count_T, BINS>, std::errc> parse_csv_histogram(std::string_view text)
+{
+	auto out = std::array<Count_T, BINS>{};
+
+	const auto error = for_each_csv_uint32(text, [&out](uint32_t value) {
+		if (value >= BINS)
+			return false;
+
+		++out[value];
+		return true;
+		});
+
+	if (std::errc{} != error) {
+		return std::unexpected(error);
+	}
+
+	return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
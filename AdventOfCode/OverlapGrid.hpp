@@ -0,0 +1,99 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Counts how many cells of a rectangle are covered more than once. Overlap scores only need to
+// tell 0, 1 and "2 or more" apart, so each cell is 2 bits, held in two dense bit planes: one for
+// cells covered at least once, one for cells covered at least twice. A cell is tallied at the
+// moment it first gets to 2, so the score is ready without scanning the grid afterwards.
+class OverlapGrid
+{
+public:
+	using Point_t = Vec2d<uint32_t>;
+
+	// The grid covers [min, max] inclusive.
+	OverlapGrid(Point_t min, Point_t max)
+		: _min{ min }
+		, _width{ uint64_t{ max.x } - min.x + 1 }
+		, _once(_word_count(cell_count(min, max)))
+		, _twice(_once.size())
+	{}
+
+	static uint64_t cell_count(Point_t min, Point_t max)
+	{
+		return (uint64_t{ max.x } - min.x + 1) * (uint64_t{ max.y } - min.y + 1);
+	}
+
+	void add(const Point_t& point)
+	{
+		const auto cell = _cell(point);
+		_add_bits(cell / 64, uint64_t{ 1 } << (cell % 64));
+	}
+
+	// The run of a row from first to last, inclusive, a word of cells at a time.
+	void add(const Point_t& first, const Point_t& last)
+	{
+		const auto end = _cell(last) + 1;
+		for (auto cell = _cell(first); cell < end; ) {
+			const auto offset = cell % 64;
+			const auto bits = std::min(64 - offset, end - cell);
+			const auto mask = (64 == bits ? ~uint64_t{ 0 } : (uint64_t{ 1 } << bits) - 1) << offset;
+
+			_add_bits(cell / 64, mask);
+			cell += bits;
+		}
+	}
+
+	// Cells covered more than once.
+	uint32_t overlaps() const { return _overlaps; }
+
+private:
+
+	uint64_t _cell(const Point_t& point) const
+	{
+		return (uint64_t{ point.y } - _min.y) * _width + (point.x - _min.x);
+	}
+
+	void _add_bits(size_t word, uint64_t mask)
+	{
+		auto& once = _once[word];
+		auto& twice = _twice[word];
+
+		const auto reached_two = once & ~twice & mask;
+		_overlaps += static_cast<uint32_t>(std::popcount(reached_two));
+		twice |= reached_two;
+		once |= mask;
+	}
+
+	static size_t _word_count(uint64_t cells)
+	{
+		return static_cast<size_t>((cells + 63) / 64);
+	}
+
+	Point_t _min;
+	uint64_t _width;
+	std::vector<uint64_t> _once;
+	std::vector<uint64_t> _twice;
+	uint32_t _overlaps{ 0 };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
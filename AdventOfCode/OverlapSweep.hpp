@@ -0,0 +1,299 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Counts the cells covered by at least two horizontal, vertical or 45° lines without visiting
+// the cells, so the cost depends on the number of lines and crossings rather than their length.
+//
+// Each line lies on a carrier, the full infinite line, identified by a linear function of the
+// cell that is constant along it. Lines on the same carrier are intervals of it: after sorting,
+// one pass finds where they cover it at all and where at least twice. Every other doubly covered
+// cell is a crossing of two carriers of different headings. Relative to such a pair the lines
+// are orthogonal segments, each spanning an interval of the other heading's carrier values, so
+// the crossings are found by a sweep over those values with the carriers of one heading active.
+class OverlapSweep
+{
+public:
+	using Point_t = Vec2d<uint32_t>;
+
+	void add(const Point_t& start, const Point_t& finish)
+	{
+		const auto heading = _heading_of(start, finish);
+
+		auto first = _position(heading, start);
+		auto last = _position(heading, finish);
+		if (first > last)
+			std::swap(first, last);
+
+		_lines[heading].push_back({ _carrier(heading, start), { first, last } });
+	}
+
+	uint64_t overlaps() const
+	{
+		auto coverages = std::array<std::vector<Coverage>, heading_count>{};
+		for (size_t heading = 0; heading < heading_count; ++heading) {
+			coverages[heading] = _coverages_of(_lines[heading]);
+		}
+
+		auto out = uint64_t{ 0 };
+		for (const auto& heading_coverages : coverages) {
+			for (const auto& coverage : heading_coverages) {
+				for (const auto& interval : coverage.twice) {
+					out += static_cast<uint64_t>(interval.last - interval.first + 1);
+				}
+			}
+		}
+
+		auto crossings = std::vector<std::pair<int64_t, int64_t>>{};
+		for (size_t a = 0; a < heading_count; ++a) {
+			for (size_t b = a + 1; b < heading_count; ++b) {
+				_find_crossings(a, coverages[a], b, coverages[b], crossings);
+			}
+		}
+
+		std::sort(crossings.begin(), crossings.end());
+		crossings.erase(std::unique(crossings.begin(), crossings.end()), crossings.end());
+
+		// A crossing may already have been counted, once for each heading whose carrier covers it
+		// twice. Either way it's to be counted exactly once.
+		for (const auto& [x, y] : crossings) {
+			const auto counted = std::count_if(_headings.begin(), _headings.end(), [&coverages, x, y](size_t heading) {
+				return _covers_twice(coverages[heading], _carrier(heading, x, y), _position(heading, x, y));
+				});
+
+			out = out + 1 - static_cast<uint64_t>(counted);
+		}
+
+		return out;
+	}
+
+private:
+
+	// Carriers are coefficients[0] * x + coefficients[1] * y. Positions along them are x, except
+	// for vertical carriers, where it's y.
+	enum Heading : size_t
+	{
+		horizontal,
+		vertical,
+		rising,		// y - x is constant
+		falling,	// x + y is constant
+		heading_count,
+	};
+
+	static constexpr auto _coefficients = std::array<std::array<int64_t, 2>, heading_count>{ { { 0, 1 }, { 1, 0 }, { -1, 1 }, { 1, 1 } } };
+	static constexpr auto _headings = std::array<size_t, heading_count>{ horizontal, vertical, rising, falling };
+
+	struct Interval
+	{
+		int64_t first;
+		int64_t last;
+	};
+
+	struct Coverage
+	{
+		int64_t carrier;
+		std::vector<Interval> once;		// disjoint and not touching, in order
+		std::vector<Interval> twice;	// disjoint, in order
+	};
+
+	static Heading _heading_of(const Point_t& start, const Point_t& finish)
+	{
+		const auto line = Line2d<uint32_t>{ start, finish };
+		if (is_horizontal(line))
+			return horizontal;
+
+		if (is_vertical(line))
+			return vertical;
+
+		if (!is_diagonal(line))
+			throw Exception("Only horizontal, vertical or diagonal lines can be swept");
+
+		return (start.x < finish.x) == (start.y < finish.y) ? rising : falling;
+	}
+
+	static int64_t _carrier(size_t heading, int64_t x, int64_t y)
+	{
+		return _coefficients[heading][0] * x + _coefficients[heading][1] * y;
+	}
+
+	static int64_t _carrier(size_t heading, const Point_t& point)
+	{
+		return _carrier(heading, point.x, point.y);
+	}
+
+	static int64_t _position(size_t heading, int64_t x, int64_t y)
+	{
+		return vertical == heading ? y : x;
+	}
+
+	static int64_t _position(size_t heading, const Point_t& point)
+	{
+		return _position(heading, point.x, point.y);
+	}
+
+	// The inverse of _carrier and _position.
+	static std::pair<int64_t, int64_t> _cell(size_t heading, int64_t carrier, int64_t position)
+	{
+		switch (heading)
+		{
+		case horizontal: return { position, carrier };
+		case vertical: return { carrier, position };
+		case rising: return { position, carrier + position };
+		default: return { position, carrier - position };
+		}
+	}
+
+	// Lines sorted by carrier and then first position; each carrier's intervals merged into the
+	// ones covered at all and the ones covered at least twice. A position is covered twice if the
+	// line it's on starts no further on than where the lines before it reach.
+	static std::vector<Coverage> _coverages_of(std::vector<std::pair<int64_t, Interval>> lines)
+	{
+		std::sort(lines.begin(), lines.end(), [](const auto& l1, const auto& l2) {
+			return std::tie(l1.first, l1.second.first) < std::tie(l2.first, l2.second.first);
+			});
+
+		auto out = std::vector<Coverage>{};
+		for (const auto& [carrier, interval] : lines) {
+			if (out.empty() || out.back().carrier != carrier) {
+				out.push_back({ carrier, { interval }, {} });
+				continue;
+			}
+
+			auto& coverage = out.back();
+			auto& reach = coverage.once.back();
+
+			if (interval.first <= reach.last) {
+				const auto twice = Interval{ interval.first, std::min(interval.last, reach.last) };
+				if (!coverage.twice.empty() && twice.first <= coverage.twice.back().last)
+					coverage.twice.back().last = std::max(coverage.twice.back().last, twice.last);
+				else
+					coverage.twice.push_back(twice);
+			}
+
+			if (interval.first <= reach.last + 1)
+				reach.last = std::max(reach.last, interval.last);
+			else
+				coverage.once.push_back(interval);
+		}
+
+		return out;
+	}
+
+	static bool _covers_twice(const std::vector<Coverage>& coverages, int64_t carrier, int64_t position)
+	{
+		const auto coverage = std::lower_bound(coverages.begin(), coverages.end(), carrier, [](const Coverage& c, int64_t value) {
+			return c.carrier < value;
+			});
+
+		if (coverages.end() == coverage || coverage->carrier != carrier)
+			return false;
+
+		const auto interval = std::upper_bound(coverage->twice.begin(), coverage->twice.end(), position, [](int64_t value, const Interval& i) {
+			return value < i.first;
+			});
+
+		return coverage->twice.begin() != interval && position <= std::prev(interval)->last;
+	}
+
+	// The carriers of heading a are active between the b-carrier values at their ends; each
+	// interval of a b carrier then queries the active a carriers over the a-carrier values that it
+	// spans. Rising and falling carriers only meet on a cell if their values have the same parity,
+	// so for that pair the active carriers are kept apart by parity and a query only looks at the
+	// ones it can meet; every carrier it visits is then a crossing.
+	static void _find_crossings(size_t a, const std::vector<Coverage>& a_coverages, size_t b, const std::vector<Coverage>& b_coverages, std::vector<std::pair<int64_t, int64_t>>& crossings)
+	{
+		enum EventKind { insert, query, remove };
+		struct Event
+		{
+			int64_t at;
+			EventKind kind;
+			int64_t carrier;
+			Interval span;
+		};
+
+		auto span_on = [](size_t on, size_t heading, int64_t carrier, const Interval& interval) {
+			const auto [x0, y0] = _cell(heading, carrier, interval.first);
+			const auto [x1, y1] = _cell(heading, carrier, interval.last);
+			const auto v0 = _carrier(on, x0, y0);
+			const auto v1 = _carrier(on, x1, y1);
+
+			return Interval{ std::min(v0, v1), std::max(v0, v1) };
+		};
+
+		auto events = std::vector<Event>{};
+		for (const auto& coverage : a_coverages) {
+			for (const auto& interval : coverage.once) {
+				const auto span = span_on(b, a, coverage.carrier, interval);
+				events.push_back({ span.first, insert, coverage.carrier, {} });
+				events.push_back({ span.last, remove, coverage.carrier, {} });
+			}
+		}
+
+		for (const auto& coverage : b_coverages) {
+			for (const auto& interval : coverage.once) {
+				events.push_back({ coverage.carrier, query, coverage.carrier, span_on(a, b, coverage.carrier, interval) });
+			}
+		}
+
+		std::sort(events.begin(), events.end(), [](const Event& e1, const Event& e2) {
+			return std::tie(e1.at, e1.kind) < std::tie(e2.at, e2.kind);
+			});
+
+		const auto [a_x, a_y] = _coefficients[a];
+		const auto [b_x, b_y] = _coefficients[b];
+		const auto determinant = a_x * b_y - a_y * b_x;
+
+		const auto by_parity = 2 == std::abs(determinant);
+		auto parity = [by_parity](int64_t carrier) { return by_parity ? static_cast<size_t>(carrier & 1) : size_t{ 0 }; };
+
+		auto active = std::array<std::set<int64_t>, 2>{};
+		for (const auto& event : events) {
+			switch (event.kind)
+			{
+			case insert:
+				active[parity(event.carrier)].insert(event.carrier);
+				break;
+			case remove:
+				active[parity(event.carrier)].erase(event.carrier);
+				break;
+			case query: {
+				const auto& candidates = active[parity(event.carrier)];
+				for (auto it = candidates.lower_bound(event.span.first); candidates.end() != it && *it <= event.span.last; ++it) {
+					const auto x = *it * b_y - a_y * event.carrier;
+					const auto y = a_x * event.carrier - b_x * *it;
+					crossings.emplace_back(x / determinant, y / determinant);
+				}
+				break;
+			}
+			}
+		}
+	}
+
+	std::array<std::vector<std::pair<int64_t, Interval>>, heading_count> _lines;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
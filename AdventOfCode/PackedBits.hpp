@@ -0,0 +1,160 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<size_t WIDTH>
+using packed_word_t = std::conditional_t<WIDTH <= 8, uint8_t,
+	std::conditional_t<WIDTH <= 16, uint16_t,
+	std::conditional_t<WIDTH <= 32, uint32_t, uint64_t>>>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A fixed number of bits, read left to right: element 0 is the first, most significant, bit.
+// Up to 64 bits fit in the smallest unsigned word that holds them; wider values take as many
+// 64-bit words as they need, least significant word first.
+template<size_t WIDTH>
+	requires (WIDTH > 0)
+class PackedBits
+{
+public:
+	using This_t = PackedBits<WIDTH>;
+	using Word_t = detail::packed_word_t<WIDTH>;
+
+	static constexpr size_t width = WIDTH;
+	static constexpr size_t word_bits = std::numeric_limits<Word_t>::digits;
+	static constexpr size_t word_count = (WIDTH + word_bits - 1) / word_bits;
+
+	class ConstIterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::forward_iterator_tag;
+		using value_type = bool;
+		using difference_type = std::ptrdiff_t;
+		using reference = bool;
+		using pointer = void;
+
+		constexpr ConstIterator() = default;
+		constexpr ConstIterator(const This_t* bits, size_t index) : _bits{ bits }, _index{ index } {}
+
+		constexpr bool operator*() const { return (*_bits)[_index]; }
+
+		constexpr ConstIterator& operator++() { ++_index; return *this; }
+		constexpr ConstIterator operator++(int) { auto out = *this; ++_index; return out; }
+
+		constexpr bool operator==(const ConstIterator&) const = default;
+
+	private:
+		const This_t* _bits{ nullptr };
+		size_t _index{ 0 };
+	};
+
+	constexpr PackedBits() = default;
+
+	// The first bit is the most significant; missing trailing bits are zero.
+	constexpr PackedBits(std::initializer_list<bool> bits)
+	{
+		auto index = size_t{ 0 };
+		for (auto bit = bits.begin(); bit != bits.end() && index < WIDTH; ++bit, ++index) {
+			set(WIDTH - 1 - index, *bit);
+		}
+	}
+
+	static constexpr This_t from_word(uint64_t word)
+		requires (WIDTH <= 64)
+	{
+		auto out = This_t{};
+		out._words[0] = static_cast<Word_t>(word) & _top_word_mask;
+		return out;
+	}
+
+	static constexpr size_t size() { return WIDTH; }
+
+	// Bit index, counting from the first (most significant) one.
+	constexpr bool operator[](size_t index) const { return test(WIDTH - 1 - index); }
+
+	// Bit of significance 2^position.
+	constexpr bool test(size_t position) const
+	{
+		return 0 != ((_words[position / word_bits] >> (position % word_bits)) & 1);
+	}
+
+	constexpr void set(size_t position, bool value)
+	{
+		const auto mask = static_cast<Word_t>(Word_t{ 1 } << (position % word_bits));
+		auto& word = _words[position / word_bits];
+		word = value ? static_cast<Word_t>(word | mask) : static_cast<Word_t>(word & ~mask);
+	}
+
+	// Least significant word first.
+	constexpr std::span<const Word_t, word_count> words() const { return _words; }
+
+	constexpr This_t flipped() const
+	{
+		auto out = This_t{};
+		std::transform(_words.begin(), _words.end(), out._words.begin(), [](Word_t word) { return static_cast<Word_t>(~word); });
+		out._words.back() &= _top_word_mask;
+
+		return out;
+	}
+
+	// The low bits, if Out_T is narrower than WIDTH.
+	template<typename Out_T>
+	constexpr Out_T as() const
+	{
+		auto out = Out_T{ 0 };
+		for (size_t i = word_count; i-- > 0; ) {
+			if constexpr (sizeof(Out_T) > sizeof(Word_t))
+				out <<= word_bits;
+			else
+				out = Out_T{ 0 };
+
+			out |= static_cast<Out_T>(_words[i]);
+		}
+
+		return out;
+	}
+
+	constexpr ConstIterator begin() const { return { this, 0 }; }
+	constexpr ConstIterator end() const { return { this, WIDTH }; }
+
+	constexpr bool operator==(const This_t&) const = default;
+
+private:
+	static constexpr size_t _top_word_bits = WIDTH - (word_count - 1) * word_bits;
+	static constexpr auto _top_word_mask = static_cast<Word_t>(std::numeric_limits<Word_t>::max() >> (word_bits - _top_word_bits));
+
+	std::array<Word_t, word_count> _words{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
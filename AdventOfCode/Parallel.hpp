@@ -0,0 +1,233 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline constexpr size_t cache_line_size = 64;
+
+// A value on a cache line of its own, so that threads updating neighbouring values don't contend.
+template<typename Value_T>
+struct alignas(cache_line_size) CacheAligned
+{
+	Value_T value{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A fixed set of threads that run the tasks of one job at a time. The thread that calls run()
+// works on the job too, so a pool of thread_count threads starts thread_count - 1 of its own.
+// run() can be called from inside a task, in which case the nested job just runs on that thread.
+class ThreadPool
+{
+public:
+	explicit ThreadPool(size_t thread_count = default_thread_count())
+		: _thread_count{ std::max(thread_count, size_t{ 1 }) }
+	{
+		_workers.reserve(_thread_count - 1);
+		for (size_t i = 1; i < _thread_count; ++i) {
+			_workers.emplace_back([this]() { _work(); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			auto lock = std::lock_guard{ _mutex };
+			_stopping = true;
+		}
+
+		_job_posted.notify_all();
+		for (auto& worker : _workers) {
+			worker.join();
+		}
+	}
+
+	static size_t default_thread_count()
+	{
+		return std::max(size_t{ std::thread::hardware_concurrency() }, size_t{ 1 });
+	}
+
+	// Shared by everything that doesn't bring its own pool.
+	static ThreadPool& shared()
+	{
+		static auto pool = ThreadPool{};
+		return pool;
+	}
+
+	size_t thread_count() const { return _thread_count; }
+
+	// Calls task(i) for every i in [0, task_count), spread over the pool, and returns once they have
+	// all finished. If any of them throws, the first exception is rethrown here.
+	template<typename Task_T>
+	void run(size_t task_count, Task_T&& task)
+	{
+		if (0 == task_count)
+			return;
+
+		if (1 == _thread_count || 1 == task_count || _inside_task()) {
+			for (size_t i = 0; i < task_count; ++i) {
+				task(i);
+			}
+
+			return;
+		}
+
+		auto job_lock = std::lock_guard{ _job_mutex };
+
+		auto job = Job{ std::function<void(size_t)>{ std::ref(task) }, task_count };
+		{
+			auto lock = std::lock_guard{ _mutex };
+			_job = &job;
+			++_generation;
+		}
+
+		_job_posted.notify_all();
+		_run_tasks(job);
+
+		{
+			auto lock = std::unique_lock{ _mutex };
+			_job_finished.wait(lock, [&job]() { return job.finished == job.task_count && 0 == job.active_workers; });
+			_job = nullptr;
+		}
+
+		if (job.error)
+			std::rethrow_exception(job.error);
+	}
+
+private:
+
+	struct Job
+	{
+		std::function<void(size_t)> task;
+		size_t task_count;
+		std::atomic<size_t> next{ 0 };
+		size_t finished{ 0 };
+		size_t active_workers{ 0 };
+		std::exception_ptr error;
+	};
+
+	static bool& _inside_task()
+	{
+		thread_local auto inside = false;
+		return inside;
+	}
+
+	void _run_tasks(Job& job)
+	{
+		_inside_task() = true;
+
+		auto done = size_t{ 0 };
+		auto error = std::exception_ptr{};
+		for (auto i = job.next++; i < job.task_count; i = job.next++) {
+			try {
+				job.task(i);
+			}
+			catch (...) {
+				if (!error)
+					error = std::current_exception();
+			}
+
+			++done;
+		}
+
+		_inside_task() = false;
+
+		{
+			auto lock = std::lock_guard{ _mutex };
+			job.finished += done;
+			if (error && !job.error)
+				job.error = error;
+		}
+
+		_job_finished.notify_all();
+	}
+
+	void _work()
+	{
+		auto seen_generation = size_t{ 0 };
+		for (;;) {
+			Job* job = nullptr;
+			{
+				auto lock = std::unique_lock{ _mutex };
+				_job_posted.wait(lock, [&]() { return _stopping || (nullptr != _job && _generation != seen_generation); });
+				if (_stopping)
+					return;
+
+				seen_generation = _generation;
+				job = _job;
+				++job->active_workers;
+			}
+
+			_run_tasks(*job);
+
+			{
+				auto lock = std::lock_guard{ _mutex };
+				--job->active_workers;
+			}
+
+			_job_finished.notify_all();
+		}
+	}
+
+	size_t _thread_count;
+	std::vector<std::thread> _workers;
+
+	std::mutex _job_mutex;	// one job at a time
+
+	std::mutex _mutex;
+	std::condition_variable _job_posted;
+	std::condition_variable _job_finished;
+	Job* _job{ nullptr };
+	size_t _generation{ 0 };
+	bool _stopping{ false };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Splits [0, size) into at most pool.thread_count() contiguous chunks of at least min_chunk_size
+// elements and calls chunk_task(chunk_index, begin, end) for each of them on the pool. Returns the
+// number of chunks, which is 0 for an empty range.
+template<typename ChunkTask_T>
+size_t parallel_chunks(ThreadPool& pool, size_t size, size_t min_chunk_size, ChunkTask_T&& chunk_task)
+{
+	if (0 == size)
+		return 0;
+
+	const auto max_chunks = std::clamp(size / std::max(min_chunk_size, size_t{ 1 }), size_t{ 1 }, pool.thread_count());
+	const auto chunk_size = (size + max_chunks - 1) / max_chunks;
+	const auto chunk_count = (size + chunk_size - 1) / chunk_size;
+
+	pool.run(chunk_count, [&](size_t chunk) {
+		const auto begin = chunk * chunk_size;
+		chunk_task(chunk, begin, std::min(begin + chunk_size, size));
+		});
+
+	return chunk_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
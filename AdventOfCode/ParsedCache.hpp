@@ -0,0 +1,373 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+#include "InputBuffer.hpp"
+#include "Line2dScanner.hpp"
+#include "BitLineDecoder.hpp"
+#include "NumberParsing.hpp"
+#include "StringOperations.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+// MurmurHash3's 64-bit finalizer: every bit of the input affects every bit of the output.
+constexpr uint64_t mix64(uint64_t value)
+{
+	value ^= value >> 33;
+	value *= 0xFF51AFD7ED558CCD;
+	value ^= value >> 33;
+	value *= 0xC4CEB9FE1A85EC53;
+	value ^= value >> 33;
+
+	return value;
+}
+
+}	// namespace: detail
+
+// A 64-bit hash over the text, eight bytes per step: each word, the last one padded with zeros,
+// is mixed before it's folded into the state, and the state is mixed once more at the end. Texts
+// that only differ in trailing zero bytes collide, but a cache checks the text's size as well.
+inline uint64_t content_hash(std::string_view text)
+{
+	constexpr auto prime = uint64_t{ 0x100000001B3 };
+
+	auto out = uint64_t{ 0xCBF29CE484222325 };
+	for (size_t pos = 0; pos < text.size(); pos += sizeof(uint64_t)) {
+		auto word = uint64_t{ 0 };
+		std::memcpy(&word, text.data() + pos, std::min(sizeof(word), text.size() - pos));
+		out = (out ^ detail::mix64(word)) * prime;
+	}
+
+	return detail::mix64(out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Parsed input, stored as a memory-mapped binary file next to the text it came from. The file
+// records the size and content hash of the source text, so it's only rebuilt (by parsing the text)
+// when it's missing or stale; otherwise the arrays in it are used in place, straight out of the
+// mapping. Everything stored has to be trivially copyable.
+class ParsedCache
+{
+public:
+	static constexpr uint32_t format_version = 2;
+	static constexpr size_t max_sections = 4;
+
+	enum class Kind : uint32_t
+	{
+		vent_lines = 1,
+		diagnostic_log,
+		bingo_game,
+		positions,
+	};
+
+	class Writer
+	{
+	public:
+		template<typename Element_T>
+			requires std::is_trivially_copyable_v<Element_T>
+		void add(std::span<const Element_T> elements)
+		{
+			if (_sections.size() == max_sections) {
+				throw Exception(std::format("A parsed-input cache can hold at most {} sections", max_sections));
+			}
+
+			auto& section = _sections.emplace_back();
+			section.element_size = sizeof(Element_T);
+			section.count = elements.size();
+			section.bytes.resize(elements.size_bytes());
+			std::memcpy(section.bytes.data(), elements.data(), elements.size_bytes());
+		}
+
+		template<typename Element_T>
+		void add(const std::vector<Element_T>& elements)
+		{
+			add(std::span<const Element_T>{ elements });
+		}
+
+	private:
+		friend class ParsedCache;
+
+		struct Section
+		{
+			uint64_t element_size;
+			uint64_t count;
+			std::vector<char> bytes;
+		};
+
+		std::vector<Section> _sections;
+	};
+
+	static std::filesystem::path default_path(const std::filesystem::path& source_path)
+	{
+		auto out = source_path;
+		out += ".aoccache";
+
+		return out;
+	}
+
+	// build(text, writer) is only called when the cache needs to be (re)built.
+	template<typename Build_T>
+	static ParsedCache open(const std::filesystem::path& source_path, const std::filesystem::path& cache_path, Kind kind, Build_T&& build)
+	{
+		const auto source = InputBuffer{ source_path };
+		const auto source_hash = content_hash(source.view());
+
+		if (std::filesystem::exists(cache_path)) {
+			auto cache = ParsedCache{ InputBuffer{ cache_path } };
+			if (cache._is_valid_for(kind, source.size(), source_hash))
+				return cache;
+		}
+
+		auto writer = Writer{};
+		build(source.view(), writer);
+		_write(cache_path, kind, source.size(), source_hash, writer);
+
+		auto out = ParsedCache{ InputBuffer{ cache_path } };
+		if (!out._is_valid_for(kind, source.size(), source_hash)) {
+			throw Exception(std::format("Failed to write parsed-input cache {}", cache_path.string()));
+		}
+
+		out._rebuilt = true;
+
+		return out;
+	}
+
+	// Whether the text had to be parsed to produce this cache.
+	bool rebuilt() const { return _rebuilt; }
+
+	size_t section_count() const { return _header().section_count; }
+
+	template<typename Element_T>
+		requires std::is_trivially_copyable_v<Element_T>
+	std::span<const Element_T> section(size_t index) const
+	{
+		if (index >= section_count()) {
+			throw Exception(std::format("Parsed-input cache has no section {}", index));
+		}
+
+		const auto& section = _header().sections[index];
+		if (sizeof(Element_T) != section.element_size) {
+			throw Exception(std::format("Parsed-input cache section {} holds {}-byte elements, not {}-byte ones",
+				index, section.element_size, sizeof(Element_T)));
+		}
+
+		return { reinterpret_cast<const Element_T*>(_mapping.data() + section.offset), static_cast<size_t>(section.count) };
+	}
+
+private:
+
+	struct SectionEntry
+	{
+		uint64_t offset;
+		uint64_t element_size;
+		uint64_t count;
+	};
+
+	struct Header
+	{
+		std::array<char, 8> magic;
+		uint32_t version;
+		Kind kind;
+		uint64_t source_size;
+		uint64_t source_hash;
+		uint64_t section_count;
+		std::array<SectionEntry, max_sections> sections;
+	};
+
+	static constexpr auto magic = std::array<char, 8>{ 'A', 'O', 'C', 'C', 'A', 'C', 'H', 'E' };
+	static constexpr size_t section_alignment = 64;
+
+	explicit ParsedCache(InputBuffer mapping)
+		: _mapping{ std::move(mapping) }
+	{}
+
+	const Header& _header() const
+	{
+		return *reinterpret_cast<const Header*>(_mapping.data());
+	}
+
+	bool _is_valid_for(Kind kind, uint64_t source_size, uint64_t source_hash) const
+	{
+		if (_mapping.size() < sizeof(Header))
+			return false;
+
+		const auto& header = _header();
+		if (magic != header.magic || format_version != header.version || kind != header.kind
+			|| source_size != header.source_size || source_hash != header.source_hash || header.section_count > max_sections)
+			return false;
+
+		for (size_t i = 0; i < header.section_count; ++i) {
+			const auto& section = header.sections[i];
+			if (section.offset % section_alignment != 0 || section.offset > _mapping.size()
+				|| (0 != section.element_size && section.count > (_mapping.size() - section.offset) / section.element_size))
+				return false;
+		}
+
+		return true;
+	}
+
+	static void _write(const std::filesystem::path& cache_path, Kind kind, uint64_t source_size, uint64_t source_hash, const Writer& writer)
+	{
+		auto header = Header{ magic, format_version, kind, source_size, source_hash, static_cast<uint64_t>(writer._sections.size()), {} };
+
+		auto offset = uint64_t{ (sizeof(Header) + section_alignment - 1) / section_alignment * section_alignment };
+		for (size_t i = 0; i < writer._sections.size(); ++i) {
+			header.sections[i] = { offset, writer._sections[i].element_size, writer._sections[i].count };
+			offset += (writer._sections[i].bytes.size() + section_alignment - 1) / section_alignment * section_alignment;
+		}
+
+		// Written to the side and moved into place, so a reader never maps a half-written cache.
+		auto temp_path = cache_path;
+		temp_path += ".tmp";
+
+		{
+			auto file = std::ofstream{ temp_path, std::ios::binary | std::ios::trunc };
+			if (!file.is_open()) {
+				throw Exception(std::format("Failed to create parsed-input cache {}", temp_path.string()));
+			}
+
+			auto write_padded = [&file](const char* data, size_t size) {
+				static constexpr auto padding = std::array<char, section_alignment>{};
+
+				file.write(data, static_cast<std::streamsize>(size));
+				file.write(padding.data(), static_cast<std::streamsize>((section_alignment - size % section_alignment) % section_alignment));
+			};
+
+			write_padded(reinterpret_cast<const char*>(&header), sizeof(header));
+			for (const auto& section : writer._sections) {
+				write_padded(section.bytes.data(), section.bytes.size());
+			}
+
+			if (!file) {
+				throw Exception(std::format("Failed to write parsed-input cache {}", temp_path.string()));
+			}
+		}
+
+		std::filesystem::rename(temp_path, cache_path);
+	}
+
+	InputBuffer _mapping;
+	bool _rebuilt{ false };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Section 0: Line2d<uint32_t>
+inline ParsedCache cache_vent_lines(const std::filesystem::path& source_path, const std::filesystem::path& cache_path)
+{
+	return ParsedCache::open(source_path, cache_path, ParsedCache::Kind::vent_lines, [](std::string_view text, ParsedCache::Writer& writer) {
+		const auto lines = scan_line2ds<uint32_t>(text);
+		if (!lines)
+			throw Exception(std::format("Invalid vent line at byte offset {}", lines.error().offset));
+
+		writer.add(*lines);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Section 0: the entries as packed uint64_t, first bit most significant
+inline ParsedCache cache_diagnostic_log(const std::filesystem::path& source_path, const std::filesystem::path& cache_path, size_t entry_width)
+{
+	return ParsedCache::open(source_path, cache_path, ParsedCache::Kind::diagnostic_log, [entry_width](std::string_view text, ParsedCache::Writer& writer) {
+		const auto entries = BitLineDecoder{ entry_width }.decode(text);
+		if (!entries)
+			throw Exception(std::format("Invalid log line at byte offset {}", entries.error().offset));
+
+		writer.add(*entries);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Section 0: the draws (uint8_t); section 1: the board cells (uint8_t), row by row, 25 per board
+inline ParsedCache cache_bingo_game(const std::filesystem::path& source_path, const std::filesystem::path& cache_path)
+{
+	return ParsedCache::open(source_path, cache_path, ParsedCache::Kind::bingo_game, [](std::string_view text, ParsedCache::Writer& writer) {
+		constexpr auto board_size = size_t{ 5 };
+
+		auto reader = LineReader{ text };
+
+		auto draws = std::vector<uint8_t>{};
+		const auto error = for_each_csv_uint32(reader.next().value_or(std::string_view{}), [&draws](uint32_t value) {
+			if (value > std::numeric_limits<uint8_t>::max())
+				return false;
+
+			draws.push_back(static_cast<uint8_t>(value));
+			return true;
+			});
+
+		if (std::errc{} != error)
+			throw Exception(std::format("Failed to read bingo draws: {}", conversion_error_message(error)));
+
+		auto cells = std::vector<uint8_t>{};
+		while (!reader.at_end()) {
+			const auto offset = reader.offset();
+			const auto line = *reader.next();
+			if (line.empty())
+				continue;
+
+			const auto row_begin = cells.size();
+			for (const auto value_str : split_view(line, ' ', SplitBehaviour::drop_empty)) {
+				const auto value = try_string_to<uint8_t>(value_str);
+				if (!value)
+					throw Exception(std::format("Invalid board value at byte offset {}", offset));
+
+				cells.push_back(*value);
+			}
+
+			if (cells.size() - row_begin != board_size)
+				throw Exception(std::format("Invalid bingo board row at byte offset {}", offset));
+		}
+
+		if (cells.size() % (board_size * board_size) != 0)
+			throw Exception("Invalid bingo board size board");
+
+		writer.add(draws);
+		writer.add(cells);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Section 0: uint32_t
+inline ParsedCache cache_positions(const std::filesystem::path& source_path, const std::filesystem::path& cache_path)
+{
+	return ParsedCache::open(source_path, cache_path, ParsedCache::Kind::positions, [](std::string_view text, ParsedCache::Writer& writer) {
+		const auto positions = parse_csv_uint32s(LineReader{ text }.next().value_or(std::string_view{}));
+		if (!positions)
+			throw Exception(std::format("Failed to read positions: {}", conversion_error_message(positions.error())));
+
+		writer.add(*positions);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,105 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(AOC_HAVE_AVX2)
+// Counts the set bits at each position of a repeating pattern of `period` bytes (a divisor of 32).
+// The count for bit b of pattern byte p is added to counts[8 * p + b]. Every byte lane has its own
+// eight 8-bit counters, which are spilled to the 64-bit totals before they can overflow. Returns
+// the number of bytes consumed, a multiple of 32.
+inline size_t positional_popcount_avx2(const uint8_t* bytes, size_t size, size_t period, uint64_t* counts)
+{
+	constexpr size_t vector_bytes = 32;
+	constexpr size_t max_vectors_per_block = std::numeric_limits<uint8_t>::max();
+
+	const auto ones = _mm256_set1_epi8(1);
+
+	auto pos = size_t{ 0 };
+	while (pos + vector_bytes <= size) {
+		auto counters = std::array<__m256i, 8>{};
+
+		const auto block_end = pos + std::min((size - pos) / vector_bytes, max_vectors_per_block) * vector_bytes;
+		for (; pos < block_end; pos += vector_bytes) {
+			const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + pos));
+
+			[&]<int... BITS>(std::integer_sequence<int, BITS...>) {
+				((counters[BITS] = _mm256_add_epi8(counters[BITS], _mm256_and_si256(_mm256_srli_epi16(v, BITS), ones))), ...);
+			}(std::make_integer_sequence<int, 8>{});
+		}
+
+		for (size_t bit = 0; bit < 8; ++bit) {
+			alignas(32) auto lanes = std::array<uint8_t, vector_bytes>{};
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes.data()), counters[bit]);
+
+			for (size_t lane = 0; lane < vector_bytes; ++lane) {
+				counts[8 * (lane % period) + bit] += lanes[lane];
+			}
+		}
+	}
+
+	return pos;
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Per-bit population count over an array of records that are `stride` words long: for every
+// word with index i, bit b adds one to counts[(i % stride) * bits + b], where bits is the width of
+// Word_T. counts must hold at least stride * bits elements, and is added to rather than reset.
+template<typename Word_T>
+	requires std::unsigned_integral<Word_T>
+void positional_popcount(std::span<const Word_T> words, size_t stride, std::span<uint64_t> counts)
+{
+	constexpr size_t bits = std::numeric_limits<Word_T>::digits;
+
+	auto i = size_t{ 0 };
+
+#if defined(AOC_HAVE_AVX2)
+	// Byte p of the record holds bits 8p to 8p + 7 (little-endian), which matches the layout of counts.
+	const auto period = sizeof(Word_T) * stride;
+	if (32 % period == 0) {
+		i = detail::positional_popcount_avx2(reinterpret_cast<const uint8_t*>(words.data()), words.size_bytes(), period, counts.data()) / sizeof(Word_T);
+	}
+#endif
+
+	for (; i < words.size(); ++i) {
+		const auto word = words[i];
+		const auto counts_begin = (i % stride) * bits;
+		for (size_t b = 0; b < bits; ++b) {
+			counts[counts_begin + b] += (word >> b) & 1;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
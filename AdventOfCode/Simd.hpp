@@ -0,0 +1,25 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Instruction sets that the vectorized kernels may use. These follow the compiler's target
+// settings (/arch:AVX2 or -mavx2 etc.), and every kernel has a scalar fallback. Define
+// AOC_DISABLE_SIMD to force the scalar code paths.
+
+#if !defined(AOC_DISABLE_SIMD)
+
+#if defined(__AVX2__)
+#define AOC_HAVE_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AOC_HAVE_SSE2 1
+#endif
+
+#endif
+
+#if defined(AOC_HAVE_AVX2) || defined(AOC_HAVE_SSE2)
+#include <immintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
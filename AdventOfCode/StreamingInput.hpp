@@ -0,0 +1,232 @@
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Common.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace aoc
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Two-stage ingest for inputs that shouldn't (or can't) be held in memory. A reader thread fills
+// fixed-size chunks of a bounded ring while the consumer parses the ones already read, so I/O
+// overlaps with compute and memory use is capped at chunk_count * chunk_size (plus one partial
+// record). The consumer only ever sees whole records: a record cut by a chunk boundary is carried
+// over and completed from the next chunk.
+class StreamingInput
+{
+public:
+	static constexpr size_t default_chunk_size = size_t{ 1 } << 20;
+	static constexpr size_t default_chunk_count = 4;
+
+	explicit StreamingInput(const std::filesystem::path& path, size_t chunk_size = default_chunk_size, size_t chunk_count = default_chunk_count)
+		: _file{ std::make_unique<std::ifstream>(path, std::ios::binary) }
+		, _stream{ _file.get() }
+	{
+		if (!_file->is_open()) {
+			throw Exception(std::format("Failed to open {}", path.string()));
+		}
+
+		_start(chunk_size, chunk_count);
+	}
+
+	// The stream must outlive this object.
+	explicit StreamingInput(std::istream& stream, size_t chunk_size = default_chunk_size, size_t chunk_count = default_chunk_count)
+		: _stream{ &stream }
+	{
+		_start(chunk_size, chunk_count);
+	}
+
+	StreamingInput(const StreamingInput&) = delete;
+	StreamingInput& operator=(const StreamingInput&) = delete;
+
+	~StreamingInput()
+	{
+		{
+			auto lock = std::lock_guard{ _mutex };
+			_cancelled = true;
+		}
+
+		_chunk_released.notify_all();
+		_reader.join();
+	}
+
+	// Calls sink(block, offset) with consecutive blocks of the input, each made up of whole records
+	// that end in the delimiter (except, possibly, the very last one). The offset is that of the
+	// start of the block within the input. The input can only be consumed once.
+	template<typename Sink_T>
+	void for_each_block(char delimiter, Sink_T&& sink)
+	{
+		auto carry = std::string{};
+		auto offset = size_t{ 0 };
+
+		while (auto chunk = _acquire()) {
+			const auto text = std::string_view{ chunk->data.data(), chunk->size };
+
+			const auto last_delimiter = text.rfind(delimiter);
+			if (std::string_view::npos == last_delimiter) {
+				carry.append(text);
+			}
+			else {
+				auto records = text.substr(0, last_delimiter + 1);
+
+				// Only the cut record is completed in the carry; the rest of the chunk is passed on in place.
+				if (!carry.empty()) {
+					const auto first_delimiter = text.find(delimiter);
+					carry.append(text.substr(0, first_delimiter + 1));
+					sink(std::string_view{ carry }, offset);
+
+					offset += carry.size();
+					records.remove_prefix(first_delimiter + 1);
+				}
+
+				if (!records.empty()) {
+					sink(records, offset);
+					offset += records.size();
+				}
+
+				carry.assign(text.substr(last_delimiter + 1));
+			}
+
+			_release();
+		}
+
+		if (!carry.empty()) {
+			sink(std::string_view{ carry }, offset);
+		}
+	}
+
+private:
+
+	struct Chunk
+	{
+		std::vector<char> data;
+		size_t size{ 0 };
+	};
+
+	void _start(size_t chunk_size, size_t chunk_count)
+	{
+		if (0 == chunk_size || 0 == chunk_count) {
+			throw Exception("Streaming input needs at least one non-empty chunk");
+		}
+
+		_chunks.resize(chunk_count);
+		for (auto& chunk : _chunks) {
+			chunk.data.resize(chunk_size);
+		}
+
+		_reader = std::thread{ [this]() { _read_all(); } };
+	}
+
+	void _read_all()
+	{
+		try {
+			for (size_t next = 0; ; ++next) {
+				{
+					auto lock = std::unique_lock{ _mutex };
+					_chunk_released.wait(lock, [this]() { return _cancelled || _filled < _chunks.size(); });
+					if (_cancelled)
+						return;
+				}
+
+				// The consumer never touches a chunk that hasn't been published, so this happens unlocked.
+				auto& chunk = _chunks[next % _chunks.size()];
+				_stream->read(chunk.data.data(), static_cast<std::streamsize>(chunk.data.size()));
+				chunk.size = static_cast<size_t>(_stream->gcount());
+
+				const auto finished = !*_stream;
+				if (finished && _stream->bad()) {
+					throw Exception("Failed to read streaming input");
+				}
+
+				{
+					auto lock = std::lock_guard{ _mutex };
+					if (0 != chunk.size) {
+						++_filled;
+					}
+
+					_finished = finished;
+				}
+
+				_chunk_filled.notify_one();
+
+				if (finished)
+					return;
+			}
+		}
+		catch (...) {
+			{
+				auto lock = std::lock_guard{ _mutex };
+				_error = std::current_exception();
+				_finished = true;
+			}
+
+			_chunk_filled.notify_one();
+		}
+	}
+
+	// Waits for the next filled chunk; nullptr at the end of the input.
+	const Chunk* _acquire()
+	{
+		auto lock = std::unique_lock{ _mutex };
+		_chunk_filled.wait(lock, [this]() { return _filled > 0 || _finished; });
+
+		if (_error)
+			std::rethrow_exception(_error);
+
+		if (0 == _filled)
+			return nullptr;
+
+		return &_chunks[_consumed % _chunks.size()];
+	}
+
+	void _release()
+	{
+		{
+			auto lock = std::lock_guard{ _mutex };
+			--_filled;
+			++_consumed;
+		}
+
+		_chunk_released.notify_one();
+	}
+
+	std::unique_ptr<std::ifstream> _file;
+	std::istream* _stream;
+
+	std::vector<Chunk> _chunks;
+	size_t _filled{ 0 };
+	size_t _consumed{ 0 };
+	bool _finished{ false };
+	bool _cancelled{ false };
+	std::exception_ptr _error;
+
+	std::mutex _mutex;
+	std::condition_variable _chunk_filled;
+	std::condition_variable _chunk_released;
+	std::thread _reader;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}	// namespace: aoc
+
+///////////////////////////////////////////////////////////////////////////////
@@ -2,6 +2,13 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <iterator>
+#include <cstddef>
+#include <charconv>
+#include <expected>
+#include <system_error>
+#include <type_traits>
 #include <cctype>
 #include <cwctype>
 #include <algorithm>
@@ -13,33 +20,128 @@ enum class SplitBehaviour
 };
 
 template<typename Char_T>
-std::vector<std::basic_string<Char_T>> split(const std::basic_string<Char_T>& str, Char_T delimiter, SplitBehaviour behaviour = SplitBehaviour::none)
+class SplitView
 {
-    auto result = std::vector<std::basic_string<Char_T>>();
+public:
+    using StringView_t = std::basic_string_view<Char_T>;
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StringView_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const StringView_t*;
+        using reference = const StringView_t&;
+
+        Iterator() = default;
+
+        Iterator(StringView_t str, Char_T delimiter, SplitBehaviour behaviour)
+            : _remaining{ str }
+            , _delimiter{ delimiter }
+            , _behaviour{ behaviour }
+            , _done{ false }
+        {
+            _advance();
+        }
+
+        reference operator*() const { return _token; }
+        pointer operator->() const { return &_token; }
 
-    auto begin = str.cbegin();
-    while (true) {
-        if (SplitBehaviour::drop_empty == behaviour) {
-            begin = std::find_if(begin, str.end(), [delimiter](auto c) { return c != delimiter; });
+        Iterator& operator++()
+        {
+            _advance();
+            return *this;
         }
 
-        if (str.cend() == begin) {
-            break;
+        Iterator operator++(int)
+        {
+            auto out = *this;
+            _advance();
+            return out;
         }
 
-        auto pos = std::find(begin, str.cend(), delimiter);
+        bool operator==(const Iterator& other) const
+        {
+            if (_done || other._done)
+                return _done == other._done;
 
-        result.emplace_back(begin, pos);
+            return _token.data() == other._token.data() && _token.size() == other._token.size();
+        }
 
-        if (str.cend() == pos) {
-            break;
+        bool operator!=(const Iterator& other) const
+        {
+            return !(*this == other);
         }
-        else {
-            begin = std::next(pos);
+
+    private:
+        void _advance()
+        {
+            if (SplitBehaviour::drop_empty == _behaviour) {
+                const auto first = _remaining.find_first_not_of(_delimiter);
+                _remaining.remove_prefix(StringView_t::npos == first ? _remaining.size() : first);
+            }
+
+            if (_remaining.empty()) {
+                _done = true;
+                return;
+            }
+
+            const auto pos = _remaining.find(_delimiter);
+            if (StringView_t::npos == pos) {
+                _token = _remaining;
+                _remaining.remove_prefix(_remaining.size());
+            }
+            else {
+                _token = _remaining.substr(0, pos);
+                _remaining.remove_prefix(pos + 1);
+            }
         }
-    }
 
-    return result;
+        StringView_t _remaining{};
+        StringView_t _token{};
+        Char_T _delimiter{};
+        SplitBehaviour _behaviour{ SplitBehaviour::none };
+        bool _done{ true };
+    };
+
+    SplitView(StringView_t str, Char_T delimiter, SplitBehaviour behaviour = SplitBehaviour::none)
+        : _str{ str }
+        , _delimiter{ delimiter }
+        , _behaviour{ behaviour }
+    {}
+
+    Iterator begin() const { return Iterator{ _str, _delimiter, _behaviour }; }
+    Iterator end() const { return Iterator{}; }
+
+private:
+    StringView_t _str;
+    Char_T _delimiter;
+    SplitBehaviour _behaviour;
+};
+
+// Lazily splits a string into views of the original characters, so no tokens are allocated.
+// The source string has to outlive the returned view.
+template<typename Char_T>
+SplitView<Char_T> split_view(std::basic_string_view<Char_T> str, Char_T delimiter, SplitBehaviour behaviour = SplitBehaviour::none)
+{
+    return SplitView<Char_T>{ str, delimiter, behaviour };
+}
+
+template<typename Char_T>
+SplitView<Char_T> split_view(const std::basic_string<Char_T>& str, Char_T delimiter, SplitBehaviour behaviour = SplitBehaviour::none)
+{
+    return SplitView<Char_T>{ str, delimiter, behaviour };
+}
+
+template<typename Char_T>
+SplitView<Char_T> split_view(std::basic_string<Char_T>&& str, Char_T delimiter, SplitBehaviour behaviour = SplitBehaviour::none) = delete;
+
+template<typename Char_T>
+std::vector<std::basic_string<Char_T>> split(const std::basic_string<Char_T>& str, Char_T delimiter, SplitBehaviour behaviour = SplitBehaviour::none)
+{
+    const auto tokens = split_view(str, delimiter, behaviour);
+    return std::vector<std::basic_string<Char_T>>(tokens.begin(), tokens.end());
 }
 
 namespace
@@ -69,6 +171,35 @@ std::basic_string<Char_T> strip(const std::basic_string<Char_T>& str)
     return std::basic_string<Char_T>(begin, end);
 }
 
+// Locale-independent conversion of a whole token (surrounding blanks are ignored) that reports
+// failure through the result rather than by throwing: std::errc::invalid_argument for anything
+// that isn't entirely a number and std::errc::result_out_of_range if it doesn't fit in Value_T.
+template<typename Value_T>
+    requires std::is_integral_v<Value_T> && (!std::is_same_v<Value_T, bool>)
+std::expected<Value_T, std::errc> try_string_to(std::string_view str)
+{
+    constexpr auto blanks = std::string_view{ " \t\r\n" };
+
+    const auto first = str.find_first_not_of(blanks);
+    if (std::string_view::npos == first) {
+        return std::unexpected(std::errc::invalid_argument);
+    }
+
+    str = str.substr(first, str.find_last_not_of(blanks) - first + 1);
+
+    auto value = Value_T{};
+    const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (std::errc{} != error) {
+        return std::unexpected(error);
+    }
+
+    if (str.data() + str.size() != end) {
+        return std::unexpected(std::errc::invalid_argument);
+    }
+
+    return value;
+}
+
 template<typename Value_T>
 auto string_to(const std::string& str) -> Value_T
 {
@@ -6,6 +6,7 @@
 #include "../AdventOfCode/AdventOfCode.hpp"
 #include "../AdventOfCode/Lanternfish.hpp"
 #include "../AdventOfCode/CrabSorter.hpp"
+#include "../AdventOfCode/ParsedCache.hpp"
 
 #include <vector>
 #include <cstdint>
@@ -30,17 +31,25 @@ int main()
 
 	std::cout << "Running..." << std::endl;
 
+	const auto source_path = DATA_DIR / "Day5_input.txt";
+	const auto cache_path = ParsedCache::default_path(source_path);
+
 	for (int i = 0; i < 500; ++i)
 	{
-		std::ifstream data_file(DATA_DIR / "Day5_input.txt");
-		if (!data_file)
+		try
+		{
+			// Only the first iteration (or the first after the input changes) parses the text.
+			const auto vent_lines = cache_vent_lines(source_path, cache_path);
+
+			const auto vent_score = aoc::Submarine()
+				.boat_systems()
+				.detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>(vent_lines.section<Line2d<uint32_t>>(0));
+		}
+		catch (const Exception& e)
 		{
-			std::cerr << "Failed to open file" << std::endl;
+			std::cerr << e.what() << std::endl;
 			return 1;
 		}
-		const auto vent_score = aoc::Submarine()
-			.boat_systems()
-			.detect_vents<aoc::VentAnalyzer::horizontal | aoc::VentAnalyzer::vertical | aoc::VentAnalyzer::diagonal>(data_file);
 	}
 
 	std::cout << "Done" << std::endl;